@@ -0,0 +1,199 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    double timeRun(const BenchmarkRun& run, size_t ops) {
+        auto start = Clock::now();
+        run(ops);
+        return secondsSince(start);
+    }
+
+    std::string escapeJson(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+                const char* hex = "0123456789abcdef";
+                out += "\\u00";
+                out += hex[(c >> 4) & 0xf];
+                out += hex[c & 0xf];
+            }
+            else {
+                out += c;
+            }
+        }
+        return out;
+    }
+
+    // Finds "key": and returns what follows it on the line.
+    bool findField(const std::string& line, const std::string& key, size_t& pos) {
+        size_t at = line.find("\"" + key + "\"");
+        if (at == std::string::npos) return false;
+        pos = line.find(':', at);
+        if (pos == std::string::npos) return false;
+        pos++;
+        while (pos < line.size() && line[pos] == ' ') pos++;
+        return true;
+    }
+
+    // Undoes escapeJson; other escapes are kept as written.
+    bool readString(const std::string& line, const std::string& key, std::string& value) {
+        size_t pos;
+        if (!findField(line, key, pos) || pos >= line.size() || line[pos] != '"') return false;
+        value.clear();
+        for (size_t i = pos + 1; i < line.size(); i++) {
+            char c = line[i];
+            if (c == '"') return true;
+            if (c == '\\' && i + 1 < line.size()) {
+                char next = line[++i];
+                if (next == 'u' && i + 4 < line.size()) {
+                    value += static_cast<char>(std::strtol(line.substr(i + 1, 4).c_str(), nullptr, 16));
+                    i += 4;
+                }
+                else {
+                    value += next;
+                }
+                continue;
+            }
+            value += c;
+        }
+        return false;
+    }
+
+    bool readNumber(const std::string& line, const std::string& key, double& value) {
+        size_t pos;
+        if (!findField(line, key, pos)) return false;
+        value = std::strtod(line.c_str() + pos, nullptr);
+        return true;
+    }
+}
+
+BenchmarkResult runBenchmark(const Benchmark& bench, const BenchmarkSettings& settings) {
+    BenchmarkRun run = bench.setup();
+
+    // Warm caches, branch predictors and any lazily built state; this also
+    // finds how many operations fill one sample. Work the compiler can see
+    // through never fills one, so maxOps stops the doubling there.
+    const size_t maxOps = size_t(1) << 30;
+    size_t ops = 1;
+    auto warmupStart = Clock::now();
+    while (true) {
+        double elapsed = timeRun(run, ops);
+        bool full = elapsed >= settings.sampleSeconds || ops == maxOps;
+        if (!full)
+            ops *= 2;
+        if (secondsSince(warmupStart) >= settings.warmupSeconds && full)
+            break;
+    }
+
+    std::vector<double> perOp;
+    perOp.reserve(settings.samples);
+    for (size_t i = 0; i < settings.samples; i++)
+        perOp.push_back(timeRun(run, ops) * 1e9 / ops);
+
+    BenchmarkResult result;
+    result.name = bench.name;
+    result.samples = perOp.size();
+    result.opsPerSample = ops;
+    std::sort(perOp.begin(), perOp.end());
+    size_t n = perOp.size();
+    result.minNs = perOp.front();
+    result.maxNs = perOp.back();
+    result.medianNs = n % 2 ? perOp[n / 2] : (perOp[n / 2 - 1] + perOp[n / 2]) * 0.5;
+    double sum = 0;
+    for (double v : perOp) sum += v;
+    result.meanNs = sum / n;
+    double var = 0;
+    for (double v : perOp) var += (v - result.meanNs) * (v - result.meanNs);
+    result.stddevNs = n > 1 ? std::sqrt(var / (n - 1)) : 0;
+    return result;
+}
+
+void writeBenchmarkJson(std::ostream& out, const std::string& label, const std::vector<BenchmarkResult>& results) {
+    out << "{\n  \"label\": \"" << escapeJson(label) << "\",\n  \"benchmarks\": [\n";
+    out << std::setprecision(6);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& r = results[i];
+        out << "    {\"name\": \"" << escapeJson(r.name) << "\", \"samples\": " << r.samples
+            << ", \"ops_per_sample\": " << r.opsPerSample
+            << ", \"min_ns\": " << r.minNs << ", \"median_ns\": " << r.medianNs
+            << ", \"mean_ns\": " << r.meanNs << ", \"stddev_ns\": " << r.stddevNs
+            << ", \"max_ns\": " << r.maxNs << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+std::vector<BenchmarkResult> readBenchmarkJson(const std::string& file) {
+    std::ifstream in(file);
+    if (!in.is_open())
+        throw std::runtime_error("Cannot open benchmark results: " + file);
+    std::vector<BenchmarkResult> results;
+    std::string line;
+    while (std::getline(in, line)) {
+        BenchmarkResult r;
+        if (!readString(line, "name", r.name)) continue;
+        double samples = 0, ops = 0;
+        if (!readNumber(line, "median_ns", r.medianNs))
+            throw std::runtime_error("Benchmark without median_ns in " + file + ": " + r.name);
+        readNumber(line, "samples", samples);
+        readNumber(line, "ops_per_sample", ops);
+        readNumber(line, "min_ns", r.minNs);
+        readNumber(line, "mean_ns", r.meanNs);
+        readNumber(line, "stddev_ns", r.stddevNs);
+        readNumber(line, "max_ns", r.maxNs);
+        r.samples = static_cast<size_t>(samples);
+        r.opsPerSample = static_cast<size_t>(ops);
+        results.push_back(r);
+    }
+    return results;
+}
+
+int compareBenchmarks(std::ostream& out, const std::vector<BenchmarkResult>& baseline,
+                      const std::vector<BenchmarkResult>& current, double thresholdPercent) {
+    std::unordered_map<std::string, const BenchmarkResult*> base;
+    for (const auto& r : baseline)
+        base[r.name] = &r;
+
+    int regressions = 0;
+    out << std::left << std::setw(32) << "benchmark" << std::right << std::setw(14) << "base_ns"
+        << std::setw(14) << "current_ns" << std::setw(10) << "change" << "\n";
+    out << std::fixed;
+    for (const auto& r : current) {
+        out << std::left << std::setw(32) << r.name << std::right;
+        auto found = base.find(r.name);
+        if (found == base.end()) {
+            out << std::setw(14) << "-" << std::setw(14) << std::setprecision(2) << r.medianNs << "       new\n";
+            continue;
+        }
+        double before = found->second->medianNs;
+        double change = before > 0 ? (r.medianNs - before) / before * 100.0 : 0.0;
+        out << std::setw(14) << std::setprecision(2) << before << std::setw(14) << r.medianNs
+            << std::setw(9) << std::setprecision(1) << std::showpos << change << std::noshowpos << "%";
+        if (change > thresholdPercent) {
+            out << "  REGRESSION";
+            regressions++;
+        }
+        out << "\n";
+        base.erase(found);
+    }
+    for (const auto& missing : base)
+        out << std::left << std::setw(32) << missing.first << std::right << "  missing from current run\n";
+    out << std::defaultfloat;
+    return regressions;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Performs n operations of the measured kind.
+using BenchmarkRun = std::function<void(size_t)>;
+
+// One micro-benchmark. setup() builds the fixture and returns the run
+// function that owns it; it is only called for benchmarks that are run, and
+// never inside a timed sample.
+struct Benchmark {
+    std::string name;
+    std::function<BenchmarkRun()> setup;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    size_t samples = 0;
+    size_t opsPerSample = 0;
+    // Nanoseconds per operation.
+    double minNs = 0, medianNs = 0, meanNs = 0, stddevNs = 0, maxNs = 0;
+};
+
+struct BenchmarkSettings {
+    double warmupSeconds = 0.2;
+    double sampleSeconds = 0.01;   // Target length of one timed sample
+    size_t samples = 25;
+};
+
+// Keeps computed values alive so the optimiser cannot drop the work.
+inline volatile std::uint64_t benchmarkSink = 0;
+inline void consume(std::uint64_t value) {
+    benchmarkSink = value;
+}
+
+// Warms up, sizes a sample to settings.sampleSeconds, then times the samples.
+BenchmarkResult runBenchmark(const Benchmark& bench, const BenchmarkSettings& settings);
+
+// One benchmark object per line, which is what readBenchmarkJson expects.
+void writeBenchmarkJson(std::ostream& out, const std::string& label, const std::vector<BenchmarkResult>& results);
+// Reads a file written by writeBenchmarkJson. Throws std::runtime_error on failure.
+std::vector<BenchmarkResult> readBenchmarkJson(const std::string& file);
+
+// Prints medians side by side and flags every benchmark whose median got
+// slower by more than thresholdPercent. Returns the number of regressions.
+int compareBenchmarks(std::ostream& out, const std::vector<BenchmarkResult>& baseline,
+                      const std::vector<BenchmarkResult>& current, double thresholdPercent);
+
+// The engine's hot paths; see EngineBenchmarks.cpp.
+std::vector<Benchmark> engineBenchmarks();
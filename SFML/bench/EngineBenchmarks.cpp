@@ -0,0 +1,301 @@
+#include "Benchmark.h"
+#include "../include/core/Board.h"
+#include "../include/core/ServiceLocator.h"
+#include "../include/components/PositionComponent.h"
+#include "../include/components/VelocityComponent.h"
+#include "../include/entities/FirePool.h"
+#include "../include/entities/StaticEntities.h"
+#include "../include/graphics/RenderCommands.h"
+#include "../include/graphics/RenderStore.h"
+#include "../include/systems/AnimationSystem.h"
+#include "../include/utils/Bitmask.h"
+#include "../include/utils/FrameArena.h"
+#include "../include/utils/PackedArray.h"
+#include "../include/utils/Rectangle.h"
+#include "../include/utils/SpatialGrid.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+// Fixtures use fixed seeds so every run measures the same data.
+namespace {
+    const float tilePixels = 50.f;
+
+    // Textures, sprite sheets, animations, render data and particles, as
+    // Game::init provides them for a headless run: textures are decoded for
+    // their size but never uploaded, so no window or GL context is needed.
+    void provideServices() {
+        if (ServiceLocator::getRenderStore()) return;
+        ServiceLocator::provide(std::make_shared<TextureCache>(nullptr, false));
+        ServiceLocator::provide(std::make_shared<SpriteSheetCache>());
+        ServiceLocator::provide(std::make_shared<AnimationSystem>());
+        ServiceLocator::provide(std::make_shared<RenderStore>());
+        ServiceLocator::provide(std::make_shared<ParticleSystem>());
+    }
+
+    BenchmarkRun rectangleIntersects() {
+        const size_t count = 4096;
+        auto rects = std::make_shared<std::vector<Rectangle>>();
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> pos(0.f, 2000.f), size(10.f, 80.f);
+        for (size_t i = 0; i < count; i++) {
+            float x = pos(rng), y = pos(rng);
+            rects->emplace_back(Vector2f(x, y), Vector2f(x + size(rng), y + size(rng)));
+        }
+        return [rects](size_t ops) {
+            const std::vector<Rectangle>& r = *rects;
+            std::uint64_t hits = 0;
+            for (size_t i = 0; i < ops; i++)
+                hits += r[i & (count - 1)].intersects(r[(i * 7 + 3) & (count - 1)]);
+            consume(hits);
+        };
+    }
+
+    BenchmarkRun bitmaskContains() {
+        const size_t count = 4096;
+        auto masks = std::make_shared<std::vector<Bitmask>>();
+        std::mt19937 rng(2);
+        for (size_t i = 0; i < count; i++)
+            masks->emplace_back(static_cast<Bitset>(rng() & 0xff));
+        // The archetype masks Game builds: position+velocity, position+graphics, ...
+        const Bitmask wanted[4] = { Bitmask(0x06), Bitmask(0x12), Bitmask(0x0a), Bitmask(0x82) };
+        return [masks, wanted](size_t ops) {
+            const std::vector<Bitmask>& m = *masks;
+            std::uint64_t hits = 0;
+            for (size_t i = 0; i < ops; i++)
+                hits += m[i & (count - 1)].contains(wanted[i & 3]);
+            consume(hits);
+        };
+    }
+
+    struct PackedItem {
+        unsigned int id;
+        float value;
+        unsigned int getID() const { return id; }
+    };
+
+    // One op is one insert plus one remove.
+    BenchmarkRun packedArrayInsertRemove() {
+        const unsigned int batch = 1024;
+        auto items = std::make_shared<std::vector<std::shared_ptr<PackedItem>>>();
+        for (unsigned int i = 0; i < batch; i++)
+            items->push_back(std::make_shared<PackedItem>(PackedItem{ i + 1, 1.f }));
+        auto array = std::make_shared<PackedArray<PackedItem>>();
+        return [items, array](size_t ops) {
+            for (size_t done = 0; done < ops; done += batch) {
+                unsigned int n = static_cast<unsigned int>(std::min<size_t>(batch, ops - done));
+                for (unsigned int i = 0; i < n; i++)
+                    array->insert((*items)[i]->id, (*items)[i]);
+                // Even slots first, then odd, so swaps move real entries.
+                for (unsigned int i = 0; i < n; i += 2)
+                    array->remove((*items)[i]->id);
+                for (unsigned int i = 1; i < n; i += 2)
+                    array->remove((*items)[i]->id);
+            }
+            consume(array->getDense().size());
+        };
+    }
+
+    BenchmarkRun packedArrayIterate() {
+        const unsigned int count = 10000;
+        auto array = std::make_shared<PackedArray<PackedItem>>();
+        for (unsigned int i = 0; i < count; i++)
+            array->insert(i + 1, std::make_shared<PackedItem>(PackedItem{ i + 1, static_cast<float>(i) }));
+        return [array](size_t ops) {
+            const auto& dense = array->getDense();
+            float sum = 0.f;
+            for (size_t done = 0; done < ops;) {
+                for (size_t i = 0; i < dense.size() && done < ops; i++, done++)
+                    sum += dense[i]->value;
+            }
+            consume(static_cast<std::uint64_t>(sum));
+        };
+    }
+
+    BenchmarkRun velocityUpdate() {
+        const size_t count = 10000;
+        struct Movers {
+            std::vector<VelocityComponent> velocities;
+            std::vector<PositionComponent> positions;
+        };
+        auto movers = std::make_shared<Movers>();
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> dir(-1.f, 1.f);
+        for (size_t i = 0; i < count; i++) {
+            movers->velocities.emplace_back(200.f);
+            movers->velocities.back().setVelocity(dir(rng), dir(rng));
+            movers->positions.emplace_back(dir(rng) * 1000.f, dir(rng) * 1000.f);
+        }
+        return [movers](size_t ops) {
+            for (size_t done = 0; done < ops;) {
+                for (size_t i = 0; i < count && done < ops; i++, done++)
+                    movers->velocities[i].update(movers->positions[i], 1.f / 60.f);
+            }
+            consume(static_cast<std::uint64_t>(movers->positions[0].getPosition().x));
+        };
+    }
+
+    // AnimBase only describes clips; playback runs in the AnimationSystem, so
+    // that is what this measures. One op advances one animation by one tick.
+    BenchmarkRun animationUpdate() {
+        const size_t count = 4096;
+        struct Anims {
+            AnimationSystem system;
+            std::vector<sf::Sprite> sprites;
+            std::vector<sf::IntRect> frames;
+        };
+        auto anims = std::make_shared<Anims>();
+        anims->sprites.resize(count);
+        for (int i = 0; i < 8; i++)
+            anims->frames.emplace_back(i * 32, 0, 32, 32);
+        for (size_t i = 0; i < count; i++) {
+            AnimationSystem::Handle h = anims->system.add(&anims->sprites[i]);
+            // Varied frame times so frames change on different ticks.
+            anims->system.play(h, anims->frames.data(), 8, 0.05f + (i % 7) * 0.01f, true, true);
+        }
+        return [anims](size_t ops) {
+            for (size_t done = 0; done < ops; done += count)
+                anims->system.update(1.f / 60.f);
+            consume(anims->system.size());
+        };
+    }
+
+    // Command list generation for a screenful of a 256x256 board; one op is one frame.
+    BenchmarkRun boardDraw() {
+        provideServices();
+        const int size = 256;
+        struct Scene {
+            Board board{ size, size, 16 };
+            RenderCommandList commands;
+        };
+        auto scene = std::make_shared<Scene>();
+        std::mt19937 rng(4);
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                bool wall = x == 0 || y == 0 || x == size - 1 || y == size - 1 || (rng() % 8) == 0;
+                scene->board.addTile(x, y, 1.f, wall ? TileType::WALL : TileType::CORRIDOR,
+                                     wall ? "img/wall.png" : "img/floor.png");
+            }
+        }
+        return [scene](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                // Pan across the board so the visible chunks change.
+                float x = static_cast<float>((i * 37) % 200) * tilePixels;
+                float y = static_cast<float>((i * 11) % 200) * tilePixels;
+                scene->commands.clear();
+                scene->board.draw(scene->commands, Rectangle(Vector2f(x, y), Vector2f(x + 1280.f, y + 720.f)));
+            }
+            consume(scene->commands.getCommands().size());
+        };
+    }
+
+    // The player's collision pass from Game::update: grid query into the frame
+    // arena, sort by ID, dispatch through the per-type callback map.
+    BenchmarkRun collisionDispatch() {
+        provideServices();
+        struct World {
+            std::vector<std::shared_ptr<Entity>> entities;
+            SpatialGrid<Entity> grid{ tilePixels * 8 };
+            std::unordered_map<EntityType, std::function<void(Entity*)>> callbacks;
+            std::uint64_t handled = 0;
+        };
+        auto world = std::make_shared<World>();
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<int> cell(0, 199);
+        for (unsigned int i = 0; i < 10000; i++) {
+            std::shared_ptr<Entity> ent;
+            if (i % 2) ent = std::make_shared<Potion>();
+            else ent = std::make_shared<Log>();
+            ent->setPosition(cell(rng) * tilePixels, cell(rng) * tilePixels);
+            ent->init(i % 2 ? "img/potion.png" : "img/log.png", 0.5f);
+            ent->setID(i + 1);
+            world->grid.insert(ent.get(), ent->getBoundingBox());
+            world->entities.push_back(ent);
+        }
+        World* w = world.get();
+        world->callbacks[EntityType::POTION] = [w](Entity* e) { w->handled += e->getID(); };
+        world->callbacks[EntityType::LOG] = [w](Entity* e) { w->handled += e->getID() * 3; };
+
+        return [world](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                FrameArena::local().reset();
+                float x = static_cast<float>((i * 53) % 200) * tilePixels;
+                float y = static_cast<float>((i * 29) % 200) * tilePixels;
+                Rectangle player(Vector2f(x, y), Vector2f(x + 60.f, y + 60.f));
+                FrameVector<Entity*> contacts;
+                contacts.reserve(16);
+                world->grid.query(player, contacts,
+                    [](Entity* e) -> const Rectangle& { return e->getBoundingBox(); });
+                std::sort(contacts.begin(), contacts.end(),
+                    [](const Entity* a, const Entity* b) { return a->getID() < b->getID(); });
+                for (Entity* ent : contacts) {
+                    auto it = world->callbacks.find(ent->getEntityType());
+                    if (it != world->callbacks.end())
+                        it->second(ent);
+                }
+            }
+            consume(world->handled);
+        };
+    }
+
+    // Building a static entity, indexing it and dropping it again.
+    BenchmarkRun entitySpawnDestroy() {
+        provideServices();
+        auto grid = std::make_shared<SpatialGrid<Entity>>(tilePixels * 8);
+        return [grid](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                auto potion = makeTracked<Potion>(MemoryTag::Entities);
+                potion->setPosition(static_cast<float>(i % 100) * tilePixels, 0.f);
+                potion->init("img/potion.png", 0.5f);
+                potion->setID(static_cast<EntityID>(i + 1));
+                grid->insert(potion.get(), potion->getBoundingBox());
+                grid->remove(potion.get());
+            }
+        };
+    }
+
+    // The same cycle for pooled projectiles.
+    BenchmarkRun fireSpawnRelease() {
+        provideServices();
+        struct Pool {
+            FirePool fires;
+            SpatialGrid<Entity> grid{ tilePixels * 8 };
+        };
+        auto pool = std::make_shared<Pool>();
+        pool->fires.reserve(256);
+        // Recycled fires keep their IDs, which the grid is keyed on.
+        std::vector<std::shared_ptr<Fire>> issued;
+        while (pool->fires.getAvailable() > 0) {
+            issued.push_back(pool->fires.acquire(sf::Vector2f(), sf::Vector2f()));
+            issued.back()->setID(static_cast<EntityID>(issued.size()));
+        }
+        for (auto& fire : issued)
+            pool->fires.release(fire.get());
+        return [pool](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                auto fire = pool->fires.acquire(sf::Vector2f(static_cast<float>(i % 100) * tilePixels, 0.f), sf::Vector2f(1.f, 0.f));
+                pool->grid.insert(fire.get(), fire->getBoundingBox());
+                fire->deleteEntity();
+                pool->grid.remove(fire.get());
+                pool->fires.release(fire.get());
+            }
+        };
+    }
+}
+
+std::vector<Benchmark> engineBenchmarks() {
+    return {
+        { "rectangle_intersects", rectangleIntersects },
+        { "bitmask_contains", bitmaskContains },
+        { "packed_array_insert_remove", packedArrayInsertRemove },
+        { "packed_array_iterate", packedArrayIterate },
+        { "velocity_update", velocityUpdate },
+        { "animation_update", animationUpdate },
+        { "board_draw", boardDraw },
+        { "collision_dispatch", collisionDispatch },
+        { "entity_spawn_destroy", entitySpawnDestroy },
+        { "fire_spawn_release", fireSpawnRelease },
+    };
+}
@@ -0,0 +1,82 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Benchmark.h"
+
+int main(int argc, char** argv)
+{
+    // Runs from the SFML directory so the img/ paths resolve.
+    // --filter <text> runs only benchmarks whose name contains text;
+    // --samples <n> timed samples per benchmark (default 25);
+    // --out <file.json> where results are written (default benchmarks.json);
+    // --label <text> stored in the results, e.g. the commit measured;
+    // --compare <base.json> <current.json> compares two result files instead of
+    //   running, and exits with 1 if any median regressed by more than
+    //   --threshold <percent> (default 5).
+    std::string filter;
+    std::string outFile = "benchmarks.json";
+    std::string label;
+    std::string baseFile, currentFile;
+    double threshold = 5.0;
+    BenchmarkSettings settings;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error("Missing value for " + arg);
+                return argv[++i];
+            };
+            if (arg == "--filter")
+                filter = value();
+            else if (arg == "--samples")
+                settings.samples = std::stoul(value());
+            else if (arg == "--out")
+                outFile = value();
+            else if (arg == "--label")
+                label = value();
+            else if (arg == "--compare") {
+                baseFile = value();
+                currentFile = value();
+            }
+            else if (arg == "--threshold")
+                threshold = std::stod(value());
+            else
+                throw std::runtime_error("Unknown option: " + arg);
+        }
+        if (settings.samples == 0)
+            throw std::runtime_error("--samples must be at least 1");
+
+        if (!baseFile.empty()) {
+            int regressions = compareBenchmarks(std::cout, readBenchmarkJson(baseFile),
+                                                readBenchmarkJson(currentFile), threshold);
+            std::cout << regressions << " regression(s) over " << threshold << "%" << std::endl;
+            return regressions ? 1 : 0;
+        }
+
+        std::vector<BenchmarkResult> results;
+        std::cout << std::left << std::setw(32) << "benchmark" << std::right << std::setw(12) << "median_ns"
+                  << std::setw(12) << "stddev_ns" << std::setw(12) << "min_ns" << std::setw(14) << "ops/sample" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        for (const Benchmark& bench : engineBenchmarks()) {
+            if (!filter.empty() && bench.name.find(filter) == std::string::npos) continue;
+            BenchmarkResult r = runBenchmark(bench, settings);
+            std::cout << std::left << std::setw(32) << r.name << std::right << std::setw(12) << r.medianNs
+                      << std::setw(12) << r.stddevNs << std::setw(12) << r.minNs << std::setw(14) << r.opsPerSample << std::endl;
+            results.push_back(r);
+        }
+
+        std::ofstream out(outFile);
+        if (!out.is_open())
+            throw std::runtime_error("Cannot write " + outFile);
+        writeBenchmarkJson(out, label, results);
+        std::cout << "Wrote " << outFile << " (" << results.size() << " benchmarks)" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
@@ -3,8 +3,7 @@
 #include <memory>
 #include <SFML/System/Vector2.hpp>
 #include "Components.h"
-
-class Window;
+#include "../../include/graphics/RenderCommands.h"
 
 class ColliderComponent: public Component{
 public:
@@ -23,8 +22,8 @@ public:
     }
 
     // Draw bounding box (for debugging).
-    virtual void draw(Window* window) {
-        window->draw(boundingBox.getDrawableRect());
+    virtual void draw(RenderCommandList& commands) const {
+        commands.rect(boundingBox);
     }
 
     const Rectangle& getBoundingBox() const { return boundingBox; }
@@ -1,5 +1,5 @@
 #pragma once
-#include "../../include/graphics/Window.h"
+#include "../../include/graphics/RenderCommands.h"
 #include "Components.h"
 
 class Entity;
@@ -14,7 +14,7 @@ public:
 
     virtual ~GraphicsComponent() = default;
     virtual void update(Entity* entity, float elapsed) = 0;
-    virtual void draw(Window* window) = 0;
+    virtual void draw(RenderCommandList& commands) = 0;
     // Added so that the Player can access the underlying SpriteSheet if needed.
     virtual SpriteSheet* getSpriteSheet() { return nullptr; }
 };
@@ -7,7 +7,7 @@ public:
     SpriteSheetGraphicsComponent();
     ~SpriteSheetGraphicsComponent() override;
     void update(Entity* entity, float elapsed) override;
-    void draw(Window* window) override;
+    void draw(RenderCommandList& commands) override;
     SpriteSheet* getSpriteSheet() override { return &spriteSheet; }
 private:
     SpriteSheet spriteSheet;
@@ -1,29 +1,24 @@
 #pragma once
 #include "Components.h"
+#include "../../include/utils/TimerWheel.h"
 
+// Lifetime in seconds of simulation time. The game schedules the expiry on
+// its timer wheel when the entity is added; nothing visits this per frame.
 class TTLComponent: public Component{
 public:
     ComponentID getID() const override {
         return ComponentID::TTL;
     }
 
-    // Constructor: initialize ttl with the provided initial value.
-    TTLComponent(int initialTTL) : ttl(initialTTL) {}
+    explicit TTLComponent(float lifetimeSeconds) : lifetime(lifetimeSeconds), timer(InvalidTimer) {}
 
-    // update(): subtract 1 from ttl if it's greater than 0.
-    void update() {
-        if (ttl > 0) {
-            --ttl;
-        }
-    }
-
-    // getTTL(): returns the current ttl value.
-    int getTTL() const {
-        return ttl;
-    }
-    void decrementTTL() { if (ttl > 0) --ttl; }
+    float getLifetime() const { return lifetime; }
 
+    // Expiry timer, so an entity removed early can cancel it.
+    TimerID getTimer() const { return timer; }
+    void setTimer(TimerID id) { timer = id; }
 
 private:
-    int ttl; // Time-to-live counter.
+    float lifetime;
+    TimerID timer;
 };
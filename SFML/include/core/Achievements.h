@@ -0,0 +1,41 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include "GameEvents.h"
+#include "../../include/utils/EventBus.h"
+
+// Counts gameplay events from the bus and reports milestones.
+class Achievements {
+    int potionsCollected = 0;
+    int shoutsPerformed = 0;
+
+    const int requiredPotions = 6; //dynamically count them
+    const int requiredShouts = 5;
+
+public:
+    void subscribe(EventBus& bus) {
+        bus.subscribe<PotionCollected>([this](const std::vector<PotionCollected>& events) {
+            onPotionsCollected(static_cast<int>(events.size()));
+        });
+        bus.subscribe<ShoutPerformed>([this](const std::vector<ShoutPerformed>& events) {
+            onShoutsPerformed(static_cast<int>(events.size()));
+        });
+    }
+
+private:
+    void onPotionsCollected(int count) {
+        bool before = potionsCollected < requiredPotions;
+        potionsCollected += count;
+        if (before && potionsCollected >= requiredPotions) {
+            std::cout << "Achievement unlocked: All potions collected!\n";
+        }
+    }
+
+    void onShoutsPerformed(int count) {
+        bool before = shoutsPerformed < requiredShouts;
+        shoutsPerformed += count;
+        if (before && shoutsPerformed >= requiredShouts) {
+            std::cout << "Achievement unlocked: Shouted 5 times!\n";
+        }
+    }
+};
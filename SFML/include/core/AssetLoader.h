@@ -0,0 +1,33 @@
+#pragma once
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "../../include/utils/ThreadPool.h"
+
+// Decodes images and sounds on a thread pool. Requests for the same file
+// share one load and one handle until the consumer calls release(); get()
+// on a handle blocks until the asset is ready and rethrows load failures. Nothing here touches the GPU: images
+// are turned into textures by TextureCache on the thread that asks for them.
+class AssetLoader {
+public:
+    using ImageHandle = std::shared_future<std::shared_ptr<const sf::Image>>;
+    using SoundHandle = std::shared_future<std::shared_ptr<const sf::SoundBuffer>>;
+
+    explicit AssetLoader(unsigned int threads = 0);
+
+    ImageHandle requestImage(const std::string& file);
+    SoundHandle requestSound(const std::string& file);
+    // Forgets a file once its handle has been consumed, so the decoded asset
+    // lives only as long as its consumer holds it. A later request decodes again.
+    void release(const std::string& file);
+
+private:
+    ThreadPool pool;
+    std::mutex mtx;
+    std::unordered_map<std::string, ImageHandle> images;
+    std::unordered_map<std::string, SoundHandle> sounds;
+};
@@ -1,16 +1,60 @@
 #pragma once
-#pragma once
-#include <SFML/Audio.hpp>
-#include <map>
-#include <string>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "AudioSink.h"
+#include "../../include/utils/LockFreeQueue.h"
 
+namespace SoundIDs {
+    constexpr SoundID pickup = hashSoundName("pickup");
+    constexpr SoundID fire = hashSoundName("fire");
+    constexpr SoundID axe = hashSoundName("axe");
+}
+
+// Front end of the audio service. Gameplay code only pushes small commands
+// into a lock-free queue, from any thread; a dedicated audio thread drains
+// it and applies the commands to the sink, sleeping while the queue is
+// empty. Producers take the wake-up lock only when that thread is asleep.
+// Sounds must be loaded before start(). If the queue is full the command is
+// dropped and counted.
 class AudioManager {
 public:
-    void loadSound(const std::string& name, const std::string& filepath);
-    void playSound(const std::string& name);
+    static const size_t queueCapacity = 256;
+
+    explicit AudioManager(std::unique_ptr<AudioSink> sink);
+    ~AudioManager();
+
+    SoundID loadSound(const std::string& name, const std::string& filepath, const SoundSettings& settings = SoundSettings());
+    void finishLoading();
+
+    void start();
+    void stop();
+
+    void playSound(SoundID id) { push({ AudioCommand::Play, id }); }
+    void stopSound(SoundID id) { push({ AudioCommand::Stop, id }); }
+    void stopAll() { push({ AudioCommand::StopAll, 0 }); }
+
+    unsigned int getDroppedCommands() const { return dropped.load(std::memory_order_relaxed); }
 
 private:
-    std::map<std::string, sf::SoundBuffer> buffers;
-    std::map<std::string, sf::Sound> sounds;
+    struct AudioCommand {
+        enum Type : std::uint8_t { Play, Stop, StopAll } type;
+        SoundID id;
+    };
+
+    void push(const AudioCommand& cmd);
+    void run();
+    void drain();
+
+    std::unique_ptr<AudioSink> sink;
+    LockFreeQueue<AudioCommand> commands;
+    std::atomic<unsigned int> dropped;
+    std::atomic<bool> running;
+    std::atomic<bool> sleeping;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::thread thread;
 };
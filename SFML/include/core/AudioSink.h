@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Sounds are addressed by a 32-bit FNV-1a hash of their name, computed at
+// compile time for literals, so playing a sound never touches a string.
+using SoundID = std::uint32_t;
+
+constexpr SoundID hashSoundName(const char* name) {
+    SoundID hash = 2166136261u;
+    while (*name) {
+        hash ^= static_cast<unsigned char>(*name++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+struct SoundSettings {
+    int priority = 0;           // Higher wins when voices run out.
+    float cooldown = 0.05f;     // Seconds during which repeat triggers are dropped.
+    float volume = 100.f;
+};
+
+// Where AudioManager's commands end up. Sounds are registered before the
+// audio thread starts; play and stop are then only called from that thread.
+class AudioSink {
+public:
+    virtual ~AudioSink() {}
+
+    virtual SoundID loadSound(const std::string& name, const std::string& filepath, const SoundSettings& settings) = 0;
+    virtual void finishLoading() {}
+    virtual void play(SoundID id) = 0;
+    virtual void stop(SoundID id) = 0;
+    virtual void stopAll() = 0;
+};
+
+// Swallows every command; used for headless runs with no audio device.
+class NullAudioSink : public AudioSink {
+public:
+    SoundID loadSound(const std::string& name, const std::string&, const SoundSettings&) override {
+        return hashSoundName(name.c_str());
+    }
+    void play(SoundID) override {}
+    void stop(SoundID) override {}
+    void stopAll() override {}
+};
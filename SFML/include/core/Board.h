@@ -1,22 +1,58 @@
 #pragma once
+#include <cstdint>
+#include <map>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 #include "Tile.h"
 #include "../../include/graphics/TileTexture.h"
+#include "../../include/utils/GridKey.h"
 
+class Rectangle;
+class RenderCommandList;
+
+// Each cell is a one-byte code into a palette of Tile flyweights (0 = no
+// tile). Cells are grouped in square chunks that are allocated when their
+// first tile is added and freed by unloadChunk, so memory follows the
+// resident area at one byte per cell.
 class Board {
 public:
-    Board(size_t width, size_t height);
+    Board(size_t width, size_t height, int chunkTiles);
     ~Board();
 
     void addTile(int x, int y, float scale, TileType type, const std::string& textureFile);
-    void draw(class Window* wnd);
+    void unloadChunk(int cx, int cy);
+    size_t getLoadedChunkCount() const { return chunks.size(); }
+
+    // Draws only the tiles overlapping the given world-space area.
+    void draw(RenderCommandList& commands, const Rectangle& area) const;
     bool inBounds(int x, int y) const;
+    // The flyweight at a cell, or nullptr if the cell is empty or not loaded.
+    const Tile* getTile(int x, int y) const;
+    // Bumped whenever a cell changes TileType or a chunk is unloaded.
+    std::uint64_t getRevision() const { return revision; }
+    // Revision at which a chunk last changed, or 0 if it is not loaded.
+    std::uint64_t getChunkStamp(int cx, int cy) const;
+    int getChunkTiles() const { return chunkTiles; }
 
 private:
+    using Chunk = std::vector<std::uint8_t>;
+    static constexpr std::uint8_t emptyCell = 0;
+
+    std::uint8_t paletteCode(TileType type, float scale, const std::string& textureFile);
+    // Cells plus the vector header, as charged to MemoryTag::Board per chunk.
+    size_t chunkBytes() const { return static_cast<size_t>(chunkTiles) * chunkTiles + sizeof(Chunk); }
+
     size_t width, height;
-    std::vector<Tile*> grid;
+    int chunkTiles;
+    float tileSize;
+    std::uint64_t revision;
+    std::unordered_map<GridKey, Chunk> chunks;
+    std::unordered_map<GridKey, std::uint64_t> chunkStamps;
+
+    // Code n refers to palette[n - 1].
+    std::vector<Tile> palette;
+    std::map<std::pair<TileType, std::string>, std::uint8_t> paletteCodes;
 
     // Flyweight storage
     std::unordered_map<std::string, std::shared_ptr<TileTexture>> textureMap;
@@ -0,0 +1,66 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+class Board;
+
+// Shared path map toward one goal cell (the player's tile). A breadth-first
+// pass over a window of the board gives every walkable cell its distance to
+// the goal and the neighbour to step to, so any number of agents can follow
+// it with one lookup each. Fields are computed on a worker thread: the main
+// thread snapshots walkability with request() and swaps results in with poll().
+class FlowField {
+public:
+    FlowField();
+    ~FlowField();
+
+    void start();
+    void stop();
+
+    // Copies the cells within radius of goal. A request the worker has not
+    // picked up yet is replaced, so only the newest goal is ever computed.
+    void request(const Board& board, const sf::Vector2i& goal, int radius);
+    // Swaps in the newest finished field. Returns true if one arrived.
+    bool poll();
+
+    bool isReady() const { return current.ready; }
+    const sf::Vector2i& getGoal() const { return current.goal; }
+    // Offset (each axis -1..1) of the next cell toward the goal; (0, 0) at the
+    // goal, on unreachable cells and outside the field.
+    sf::Vector2i getStep(int x, int y) const;
+    // Steps to the goal, or -1 if unreachable or outside the field.
+    int getDistance(int x, int y) const;
+
+private:
+    struct Field {
+        bool ready = false;
+        sf::Vector2i origin;
+        sf::Vector2i goal;
+        int width = 0, height = 0;
+        std::vector<std::uint8_t> walkable;
+        std::vector<std::int32_t> distance;
+        std::vector<std::int8_t> step;     // Index into the neighbour table, -1 for none.
+        std::vector<std::int32_t> frontier;
+    };
+
+    static void compute(Field& field);
+    void run();
+    int indexOf(int x, int y) const;
+
+    // Buffers rotate between the three stages, so steady-state updates do not allocate.
+    Field current;      // Main thread only.
+    Field pending;      // Guarded by mutex.
+    Field working;      // Worker only.
+    Field finished;     // Guarded by mutex.
+    bool hasRequest;
+    bool hasResult;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool running;
+};
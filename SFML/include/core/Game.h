@@ -1,19 +1,32 @@
 #pragma once
 #include "../../include/graphics/Window.h"
+#include "../../include/graphics/Camera.h"
+#include "../../include/graphics/RenderThread.h"
+#include "../../include/graphics/RecordingRenderBackend.h"
 #include "../../include/core/Board.h"
+#include "../../include/core/LevelStreamer.h"
+#include "../../include/core/FlowField.h"
+#include "../../include/core/PathPlanner.h"
 #include "../../include/entities/Player.h"
+#include "../../include/entities/FirePool.h"
 #include "Command.h"
 #include <memory>
 #include <vector>
 #include <string>
 #include <SFML/System/Time.hpp>
 #include "../../include/systems/Systems.h"
+#include "../../include/systems/ParticleSystem.h"
 #include "../../include/utils/PackedArray.h"
-#include "../../include/utils/Observer.h"
+#include "../../include/utils/SpatialGrid.h"
+#include "../../include/core/Achievements.h"
+#include "../../include/utils/FileWatcher.h"
+#include "../../include/utils/TimerWheel.h"
 #include <unordered_map>
+#include <unordered_set>
 #include <functional> 
 
 class InputHandler;
+struct ActionState;
 class Player;
 class Entity;
 class System;
@@ -31,29 +44,75 @@ public:
     const int spriteWH = 50;
     const float tileScale = 2.0f;
     const float itemScale = 1.0f;
+    // Window is capped to this size; bigger levels scroll with the camera.
+    const int maxWindowWidth = 1280;
+    const int maxWindowHeight = 720;
+    // Side of a spatial grid cell, in tiles.
+    const int gridCellTiles = 4;
+    // Side of a streamed level chunk, in tiles. Chunks within streamRadius of
+    // the player's chunk are kept loaded; one more ring is kept before unloading.
+    const int chunkTiles = 16;
+    const int streamRadius = 1;
+    // Time per update spent serving queued path requests.
+    const sf::Time pathBudget = sf::milliseconds(1);
+    // Resolution of the timer wheel, in seconds.
+    const float timerTick = 0.01f;
+    // Fires built up front; the pool grows past this only under heavy fire.
+    const size_t firePoolSize = 256;
 
     void registerCollisionCallback(EntityType type, std::function<void(Entity*)> callback);
 
     Game(ECSType type = ECSType::BIG_ARRAY);
     ~Game();
 
-    void init(std::vector<std::string> lines);
+    // Indexes the level file and loads the chunks around the player spawn;
+    // the rest of the level is streamed in by update().
+    void init(const std::string& levelFile);
     void addEntity(std::shared_ptr<Entity> newEntity);
 
     void buildBoard(size_t width, size_t height);
     void initWindow(size_t width, size_t height);
 
     void handleInput();
+    // Actions mapped from this tick's input events.
+    const ActionState& getActions() const;
     void update(float elapsed);
+    // Publishes the frame's render commands; drawing happens on the render
+    // thread. Headless runs record every frame here instead, see enableRecording.
     void render(float elapsed);
-    Window* getWindow() { return &window; }
+    // nullptr for headless runs.
+    Window* getWindow() { return window.get(); }
+    // Commands queued by systems during update, drawn above the entities.
+    RenderCommandList& getOverlayCommands() { return overlayCommands; }
+
+    // Headless mode: no window is opened, textures are decoded but not
+    // uploaded, so no GL context or display is needed, and frames go to a
+    // recording backend that writes per-frame stats to the given CSV file.
+    // No render thread runs then: each frame is recorded on the simulation
+    // thread as it is built, so no frame is skipped and the memory columns
+    // belong to the tick that produced it. Call before init.
+    void enableRecording(const std::string& file);
+    bool isHeadless() const { return recorder != nullptr; }
 
     sf::Time getElapsed() const;
     void setFPS(int FPS);
+    int getFPS() const { return fps; }
     void togglePause() { paused = !paused; }
     bool isPaused() const { return paused; }
 
     std::shared_ptr<Player> getPlayer() const { return player; }
+    // Adds a fire from the projectile pool to the game.
+    std::shared_ptr<Fire> spawnFire(const sf::Vector2f& position, const sf::Vector2f& velocity);
+
+    // Runs after the given seconds of simulation time; EXPIRE deletes the
+    // entity, other events go to Entity::onTimer. Expired entities are skipped.
+    TimerID scheduleTimer(float seconds, std::shared_ptr<Entity> entity, EntityTimer event);
+    void cancelTimer(TimerID id);
+
+    // Paths toward the player's tile, shared by every enemy.
+    const FlowField& getFlowField() const { return flowField; }
+    // Individual paths, served from a queue within pathBudget per update.
+    PathPlanner& getPathPlanner() { return pathPlanner; }
 
     EntityID getIDCounter();
     std::shared_ptr<Entity> getEntity(unsigned int idx);
@@ -61,7 +120,7 @@ public:
     template <typename T>
     std::shared_ptr<T> buildEntityAt(const std::string& filename, int col, int row)
     {
-        auto ent = std::make_shared<T>();
+        auto ent = makeTracked<T>(MemoryTag::Entities);
         float x = col * spriteWH * tileScale;
         float y = row * spriteWH * tileScale;
         float cntrFactor = (tileScale - itemScale) * spriteWH * 0.5f;
@@ -76,24 +135,93 @@ private:
     void updateArchetypes(float elapsed);
     void bigArray(float elapsed);
     void updatePackedArray(float elapsed);
-    Window window;
+
+    // Level streaming.
+    struct StreamedChunk {
+        int cx = 0, cy = 0;
+        bool loaded = false;
+        // Entities spawned from this chunk, keyed by their level cell.
+        std::vector<std::pair<GridKey, std::weak_ptr<Entity>>> spawns;
+    };
+    void updateStreaming();
+    void integrateChunk(const LevelChunk& chunk);
+    void addChunkTiles(const LevelChunk& chunk);
+    void releaseChunk(StreamedChunk& chunk);
+    // Asks for a new flow field when the player changes tile or the board changes.
+    void updateFlowField();
+    // Advances simulation time and handles the timers that came due.
+    void updateTimers(float elapsed);
+
+    // Hot reload: changed textures, sprite sheets and the level file are
+    // reloaded in place between frames. Disabled for headless runs.
+    void watchAssets();
+    void checkHotReload();
+    void reloadSpriteSheet(const std::string& file);
+    void reloadLevel();
+    // Not created for headless runs: an sf::RenderWindow alone creates a GL context.
+    std::unique_ptr<Window> window;
     bool paused;
+    int fps;
     sf::Clock gameClock;
     sf::Time elapsed;
 
     std::unique_ptr<Board> board;
+    std::string levelFile;
+    std::unique_ptr<LevelStreamer> levelStreamer;
+    std::unordered_map<GridKey, StreamedChunk> chunks;
+    std::vector<LevelChunk> arrivedChunks;
+    // Cells whose pickup was collected, so reloading a chunk does not respawn it.
+    std::unordered_set<GridKey> consumedSpawns;
+
+    // Covers every resident chunk around the player.
+    FlowField flowField;
+    sf::Vector2i flowGoal;
+    std::uint64_t flowRevision;
+    bool flowRequested;
+    PathPlanner pathPlanner;
+
+    struct ScheduledEvent {
+        std::weak_ptr<Entity> entity;
+        EntityTimer event = EntityTimer::EXPIRE;
+    };
+    TimerWheel<ScheduledEvent> timers;
+    std::vector<ScheduledEvent> expiredTimers;
+    double simTime;
+
+    FileWatcher fileWatcher;
+    std::vector<std::string> changedFiles;
     std::vector<std::shared_ptr<Entity>> entities;
     std::vector<std::shared_ptr<System>> systems;
+
+    // View culling: the camera follows the player and only entities found in
+    // the grid cells overlapping its view are drawn.
+    Camera camera;
+    SpatialGrid<Entity> entityGrid;
+    std::vector<Entity*> visibleEntities;
+    RenderCommandList overlayCommands;
+
     EntityID entityCounter;
     std::shared_ptr<Player> player;
     std::unique_ptr<InputHandler> inputHandler;
     std::vector<std::shared_ptr<System>> graphicsSystems;
+    // Advances all sprite sheet animations in one batched pass per tick.
+    std::shared_ptr<AnimationSystem> animationSystem;
+    // Visual effects, outside the ECS; drawn above the entities in one batch.
+    std::shared_ptr<ParticleSystem> particleSystem;
+    FirePool firePool;
     //variables for ECS architecture selection
     ECSType ecsType;
     std::vector<Archetype> archetypes;  // For Archetypes ECS
     PackedArray<Entity> packedEntities; // Packed storage
 
-    // Added Observer Pattern support
-    std::shared_ptr<AchievementObserver> achievementObserver;
+    // Gameplay events; delivered once per tick after the simulation step.
+    std::shared_ptr<EventBus> events;
+    Achievements achievements;
     std::unordered_map<EntityType, std::function<void(Entity*)>> collisionCallbacks;
+
+    std::unique_ptr<RecordingRenderBackend> recorder;
+    // Frames built so far; the frame column of recordings.
+    unsigned long frameIndex;
+    // Declared last so it is stopped before anything it draws is destroyed.
+    RenderThread renderThread;
 };
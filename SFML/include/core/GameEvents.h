@@ -0,0 +1,19 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+
+// Gameplay events published on the EventBus. Plain data; adding one needs
+// no change anywhere else.
+
+struct PotionCollected {
+    int health;
+    sf::Vector2f position;
+};
+
+struct ShoutPerformed {
+    sf::Vector2f position;
+};
+
+struct WoodCollected {
+    int amount;
+    int total;
+};
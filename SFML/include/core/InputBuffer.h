@@ -0,0 +1,43 @@
+#pragma once
+#include <SFML/System/Clock.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include "../../include/utils/RingBuffer.h"
+
+// A key transition as reported by the window's event loop. Key::Unknown
+// with pressed == false releases every key (sent when focus is lost).
+struct KeyEvent {
+    sf::Keyboard::Key key = sf::Keyboard::Unknown;
+    bool pressed = false;
+    sf::Time time;
+};
+
+// Key events collected between two game ticks, in arrival order. Presses
+// and releases that both happen between ticks are kept, so short taps are
+// never lost the way they are with isKeyPressed polling.
+class InputBuffer {
+public:
+    static const size_t capacity = 64;
+
+    void push(sf::Keyboard::Key key, bool pressed) {
+        KeyEvent event{ key, pressed, clock.getElapsedTime() };
+        if (events.push(event)) return;
+        // Overflow: dropping a release would leave its key stuck down, so the
+        // queued events collapse into one release-all and newer ones follow it.
+        dropped += events.size();
+        events.clear();
+        events.push({ sf::Keyboard::Unknown, false, event.time });
+        events.push(event);
+    }
+    void releaseAll() { push(sf::Keyboard::Unknown, false); }
+
+    // Events discarded by overflows since the buffer was created.
+    size_t getDropped() const { return dropped; }
+
+    bool pop(KeyEvent& event) { return events.pop(event); }
+    sf::Time now() const { return clock.getElapsedTime(); }
+
+private:
+    RingBuffer<KeyEvent, capacity> events;
+    size_t dropped = 0;
+    sf::Clock clock;
+};
@@ -1,48 +1,72 @@
 #pragma once
 
 #include "Command.h"
+#include "InputBuffer.h"
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <memory>
-#include <vector>
 
 class Game;
 
-class InputHandler
-{
-public:
-    InputHandler();
-    std::shared_ptr<Command> handleInput();
+enum class Action : std::uint8_t { MoveUp, MoveLeft, MoveDown, MoveRight, Attack, Shout, Pause, ToggleMode, Count };
+using ActionMask = std::uint32_t;
 
-private:
-    std::shared_ptr<Command> pauseCommand;
+inline ActionMask actionBit(Action action) { return ActionMask(1) << static_cast<int>(action); }
+
+// Actions for one tick. held: bound key down at the end of the tick.
+// pressed: went down during the tick, even if released again before it.
+struct ActionState {
+    ActionMask held = 0;
+    ActionMask pressed = 0;
+    // Age of the oldest event consumed this tick.
+    sf::Time latency;
+
+    bool isActive(Action action) const { return ((held | pressed) & actionBit(action)) != 0; }
+    bool wasPressed(Action action) const { return (pressed & actionBit(action)) != 0; }
 };
 
 enum class InputMode { WASD, ARROWS };
 
-// Player-specific input handler (movement, attack, etc.)
-class PlayerInputHandler
+// Drains the window's key events once per tick and maps them through the
+// binding table of the current input mode into an action bitmask.
+class InputHandler
 {
 public:
-    PlayerInputHandler();
-    std::vector<std::shared_ptr<Command>>& handleInput();
+    InputHandler();
+
+    const ActionState& update(InputBuffer& buffer);
+    const ActionState& getActions() const { return actions; }
+    // Runs the game-level commands (pause, input mode) for this tick.
+    void dispatch(Game& game);
+
+    void bind(InputMode mode, sf::Keyboard::Key key, Action action);
     // Toggle between input modes
     void toggleInputMode();
     InputMode getInputMode() const;
 
 private:
-    // Movement commands
-    std::shared_ptr<Command> moveRightCommand;
-    std::shared_ptr<Command> moveLeftCommand;
-    std::shared_ptr<Command> moveUpCommand;
-    std::shared_ptr<Command> moveDownCommand;
-
-    // Attack / shout commands
-    std::shared_ptr<Command> attackCommand;
-    std::shared_ptr<Command> shoutCommand;
+    // Action index per key, or -1 when unbound.
+    using Bindings = std::array<std::int8_t, sf::Keyboard::KeyCount>;
 
-    // Command queue is cleared each frame
-    std::vector<std::shared_ptr<Command>> commandQueue;
+    ActionMask heldActions() const;
 
-    // Track input mode and toggle state
+    std::array<Bindings, 2> bindings;
+    std::bitset<sf::Keyboard::KeyCount> keysDown;
     InputMode inputMode;
-    bool togglePressed = false; // prevents mode toggle from firing repeatedly
+    ActionState actions;
+    size_t reportedDrops;
+    std::unique_ptr<Command> pauseCommand;
+};
+
+// Player-specific input handler (movement, attack, etc.)
+class PlayerInputHandler
+{
+public:
+    PlayerInputHandler();
+    // Executes the command of every active action, in Action order. Nothing is allocated per tick.
+    void handleInput(const ActionState& actions, Game& game);
+
+private:
+    std::array<std::unique_ptr<Command>, static_cast<size_t>(Action::Count)> commands;
 };
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+// Tile and spawn codes shared by the text and binary level formats.
+enum class LevelTile : std::uint8_t { NONE = 0, CORRIDOR = 1, WALL = 2 };
+enum class SpawnType : std::uint8_t { LOG = 1, POTION = 2, ENEMY = 3 };
+
+// Binary level file (.lvb), little-endian, version 1:
+//   LevelFileHeader
+//   LevelChunkEntry[chunksX * chunksY]   row-major by chunk
+//   LevelSpawn[spawnCount]               grouped by chunk, row-major within it
+//   uint8 tiles[chunksX * chunksY][chunkTiles * chunkTiles]
+// Every chunk stores a full square of LevelTile codes, padded with NONE at
+// the level edges, so a chunk is one contiguous block in the mapped file.
+namespace LevelFile {
+    const char magic[4] = { 'L', 'V', 'L', 'B' };
+    const std::uint32_t version = 1;
+    const char* const extension = ".lvb";
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t width, height;
+        std::uint32_t chunkTiles;
+        std::uint32_t chunksX, chunksY;
+        std::int32_t spawnX, spawnY;        // Player spawn, -1 if none.
+        std::uint32_t spawnCount;
+        std::uint64_t chunkTableOffset;
+        std::uint64_t spawnTableOffset;
+        std::uint64_t tileDataOffset;
+    };
+
+    struct ChunkEntry {
+        std::uint64_t tileOffset;
+        std::uint32_t firstSpawn;
+        std::uint32_t spawnCount;
+    };
+
+    static_assert(sizeof(Header) == 64, "LevelFile::Header layout changed");
+    static_assert(sizeof(ChunkEntry) == 16, "LevelFile::ChunkEntry layout changed");
+}
+
+struct LevelSpawn {
+    std::int32_t x, y;
+    SpawnType type;
+    std::uint8_t pad[3];
+};
+static_assert(sizeof(LevelSpawn) == 12, "LevelSpawn layout changed");
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "LevelSource.h"
+
+enum class SpawnDistribution { UNIFORM, CLUSTERED };
+
+struct LevelGenSettings {
+    int width = 100;
+    int height = 100;
+    float wallDensity = 0.1f;       // Chance for an inner cell to be a wall.
+    size_t logs = 50;
+    size_t potions = 50;
+    size_t enemies = 0;
+    SpawnDistribution distribution = SpawnDistribution::UNIFORM;
+    int clusters = 16;              // CLUSTERED: number of spawn centres.
+    float clusterRadius = 6.f;      // CLUSTERED: standard deviation around a centre, in tiles.
+    std::uint32_t seed = 1;
+
+    // Named stress scenarios by total entity count: "1k", "100k" or "1m".
+    // Returns false for an unknown name.
+    static bool fromScenario(const std::string& name, LevelGenSettings& out);
+};
+
+// Procedural level held in memory as text level characters, so it can be
+// played directly, saved as .txt, or converted with LevelSource::writeBinary.
+// The level is enclosed by walls and the player spawns on the free cell
+// nearest the centre. Only std::mt19937's raw output is used, so a seed
+// produces the same level on every platform.
+class GeneratedLevel : public LevelSource {
+public:
+    GeneratedLevel(const LevelGenSettings& settings, int chunkTiles);
+
+    LevelChunk readChunk(int cx, int cy) override;
+    void writeText(const std::string& file) const;
+    // Writes .lvb files in the binary format and anything else as text.
+    void save(const std::string& file);
+
+private:
+    char& cell(int x, int y) { return cells[static_cast<size_t>(y) * width + x]; }
+
+    std::vector<char> cells;
+};
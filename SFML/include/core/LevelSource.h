@@ -0,0 +1,93 @@
+#pragma once
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+#include "LevelFormat.h"
+#include "../../include/utils/MappedFile.h"
+
+// The tiles and spawns of one chunk.
+struct LevelChunk {
+    int cx = 0, cy = 0;
+    int originX = 0, originY = 0;   // Tile coordinates of the top-left cell.
+    int width = 0, height = 0;
+    std::vector<LevelTile> tiles;   // Row-major, width * height.
+    std::vector<LevelSpawn> spawns; // Level coordinates, row-major.
+    std::string error;              // Set, with no tiles, when the chunk could not be read.
+
+    LevelTile at(int x, int y) const { return tiles[y * width + x]; }
+};
+
+// Where chunks come from. readChunk may be called from a worker thread.
+class LevelSource {
+public:
+    virtual ~LevelSource() {}
+
+    // Picks the binary reader for .lvb files and the text reader otherwise.
+    static std::unique_ptr<LevelSource> open(const std::string& file, int chunkTiles);
+    // Writes any source out in the binary format.
+    static void writeBinary(LevelSource& source, const std::string& file);
+    // Level files are written next to their target and renamed over it, so
+    // a running streamer (which may have the old file mapped) and the hot
+    // reload watcher never see a truncated or half-written level. Windows
+    // refuses to replace a mapped file, so there the old one is renamed
+    // aside to "<file>.old" first and removed once nothing maps it.
+    static std::string tempFileFor(const std::string& file) { return file + ".tmp"; }
+    static void replaceFile(const std::string& tempFile, const std::string& file);
+
+    virtual LevelChunk readChunk(int cx, int cy) = 0;
+
+    size_t getWidth() const { return width; }
+    size_t getHeight() const { return height; }
+    int getChunkTiles() const { return chunkTiles; }
+    int getChunksX() const { return static_cast<int>((width + chunkTiles - 1) / chunkTiles); }
+    int getChunksY() const { return static_cast<int>((height + chunkTiles - 1) / chunkTiles); }
+    bool hasSpawn() const { return spawn.x >= 0; }
+    const sf::Vector2i& getSpawn() const { return spawn; }
+
+protected:
+    LevelSource() : width(0), height(0), chunkTiles(0), spawn(-1, -1) {}
+
+    // An empty chunk sized and placed for (cx, cy).
+    LevelChunk makeChunk(int cx, int cy) const;
+    // Decodes one row of text level characters into tile codes and spawns.
+    static void decodeRow(const char* cells, int count, int levelX, int levelY,
+                          LevelTile* tiles, std::vector<LevelSpawn>& spawns);
+
+    size_t width, height;
+    int chunkTiles;
+    sf::Vector2i spawn;
+};
+
+// The original one-character-per-tile text format. Opening makes one pass
+// to index where each row starts; chunks are read by seeking into the rows.
+class TextLevelSource : public LevelSource {
+public:
+    TextLevelSource(const std::string& file, int chunkTiles);
+    LevelChunk readChunk(int cx, int cy) override;
+
+private:
+    struct RowSpan {
+        std::streamoff offset;
+        int length;
+    };
+
+    std::vector<RowSpan> rows;
+    std::ifstream in;
+    std::mutex readMutex;
+};
+
+// Memory-mapped binary format (see LevelFormat.h). Opening only validates
+// the header and table sizes; chunks are copied straight out of the mapping.
+class BinaryLevelSource : public LevelSource {
+public:
+    explicit BinaryLevelSource(const std::string& file);
+    LevelChunk readChunk(int cx, int cy) override;
+
+private:
+    MappedFile mapping;
+    const LevelFile::ChunkEntry* chunkTable;
+    const LevelSpawn* spawnTable;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LevelSource.h"
+
+// Reads fixed-size chunks of a level on demand, from either the text or the
+// memory-mapped binary format. Chunks are read synchronously with loadNow()
+// or on a worker thread via request()/poll().
+class LevelStreamer {
+public:
+    // chunkTiles applies to text levels; binary levels carry their own.
+    explicit LevelStreamer(int chunkTiles);
+    ~LevelStreamer();
+
+    void open(const std::string& file);
+    void start();
+    void stop();
+
+    size_t getWidth() const { return source->getWidth(); }
+    size_t getHeight() const { return source->getHeight(); }
+    int getChunkTiles() const { return source->getChunkTiles(); }
+    int getChunksX() const { return source->getChunksX(); }
+    int getChunksY() const { return source->getChunksY(); }
+    bool hasSpawn() const { return source->hasSpawn(); }
+    const sf::Vector2i& getSpawn() const { return source->getSpawn(); }
+
+    LevelChunk loadNow(int cx, int cy) { return source->readChunk(cx, cy); }
+    // Queues a chunk for the worker. Results come back through poll() in request order;
+    // a chunk the worker failed to read comes back with its error set.
+    void request(int cx, int cy);
+    void poll(std::vector<LevelChunk>& out);
+
+private:
+    void run();
+
+    int chunkTiles;
+    std::unique_ptr<LevelSource> source;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::deque<sf::Vector2i> requests;
+    std::vector<LevelChunk> finished;
+    bool running;
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "../../include/utils/GridKey.h"
+
+class Board;
+
+using PathRequestID = std::uint32_t;
+
+// Hierarchical (HPA*) point-to-point paths over the board, for agents with
+// their own destinations. Every board chunk is a cluster with entrances
+// where its border meets walkable cells of a neighbour, and the paths
+// between its entrances are cached. A query searches that small entrance
+// graph and stitches the cached paths together. A cluster is rebuilt only
+// when its chunk, or a neighbour's, changes TileType or is (un)loaded.
+// Requests are queued and served by update() within a time budget.
+class PathPlanner {
+public:
+    enum class Status { Pending, Found, NotFound, Unknown };
+    // Finished results not collected within this many updates are dropped.
+    static const int resultLifetime = 120;
+
+    PathPlanner();
+
+    PathRequestID request(const sf::Vector2i& start, const sf::Vector2i& goal);
+    // Serves queued requests until the budget is spent (at least one per call).
+    void update(const Board& board, sf::Time budget);
+    // Moves a finished path out: cells after start up to and including goal.
+    Status takeResult(PathRequestID id, std::vector<sf::Vector2i>& path);
+
+    // Synchronous query, bypassing the queue.
+    bool findPath(const Board& board, const sf::Vector2i& start, const sf::Vector2i& goal, std::vector<sf::Vector2i>& path);
+    // Drops every cached cluster; call when the board is replaced.
+    void clear();
+
+    size_t getPendingCount() const { return jobs.size(); }
+    size_t getCachedClusterCount() const { return clusters.size(); }
+
+private:
+    struct Entrance {
+        int cell;               // Local cell index.
+        std::uint8_t sides;     // Bit per side this cell crosses into a neighbour.
+    };
+
+    struct Cluster {
+        int cx = 0, cy = 0;
+        std::uint64_t stamp = 0;
+        std::uint64_t neighbourStamps[4] = {};
+        std::vector<std::uint8_t> walkable;
+        std::vector<Entrance> entrances;
+        // entrances x entrances; -1 when unreachable inside the cluster.
+        std::vector<std::int32_t> costs;
+        // Local cells after the first entrance up to and including the second.
+        std::vector<std::vector<std::int32_t>> paths;
+    };
+
+    struct Job {
+        PathRequestID id;
+        sf::Vector2i start, goal;
+    };
+
+    struct Result {
+        Status status;
+        int frame;
+        std::vector<sf::Vector2i> path;
+    };
+
+    struct Node {
+        std::int32_t g;
+        GridKey parent;
+        bool fromStart;
+        bool closed;
+    };
+
+    const Cluster* getCluster(const Board& board, int cx, int cy);
+    void buildCluster(const Board& board, Cluster& cluster);
+    int entranceIndex(const Cluster& cluster, int cell) const;
+    // Breadth-first flood inside one cluster from a local cell.
+    void flood(const Cluster& cluster, int from, std::vector<std::int32_t>& dist, std::vector<std::int32_t>& parent);
+    sf::Vector2i toWorld(const Cluster& cluster, int cell) const;
+
+    std::unordered_map<GridKey, Cluster> clusters;
+    int clusterTiles;
+
+    std::deque<Job> jobs;
+    std::unordered_map<PathRequestID, Result> results;
+    PathRequestID nextID;
+    int frame;
+
+    // Search scratch, reused between queries.
+    std::unordered_map<GridKey, Node> nodes;
+    std::priority_queue<std::pair<std::int32_t, GridKey>, std::vector<std::pair<std::int32_t, GridKey>>,
+                        std::greater<std::pair<std::int32_t, GridKey>>> open;
+    std::vector<std::int32_t> startDist, startParent, goalDist, goalParent;
+    std::vector<std::int32_t> buildDist, buildParent;
+    std::vector<std::int32_t> floodQueue;
+    std::vector<GridKey> chain;
+};
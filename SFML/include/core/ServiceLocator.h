@@ -1,5 +1,12 @@
 #pragma once
 #include "AudioManager.h"
+#include "AssetLoader.h"
+#include "../../include/graphics/TextureCache.h"
+#include "../../include/graphics/SpriteSheetCache.h"
+#include "../../include/graphics/RenderStore.h"
+#include "../../include/systems/AnimationSystem.h"
+#include "../../include/systems/ParticleSystem.h"
+#include "../../include/utils/EventBus.h"
 
 class ServiceLocator {
 public:
@@ -11,6 +18,69 @@ public:
         return audioService;
     }
 
+    static void provide(std::shared_ptr<AssetLoader> service) {
+        assetService = service;
+    }
+
+    static std::shared_ptr<AssetLoader> getAssets() {
+        return assetService;
+    }
+
+    static void provide(std::shared_ptr<TextureCache> service) {
+        textureService = service;
+    }
+
+    static std::shared_ptr<TextureCache> getTextures() {
+        return textureService;
+    }
+
+    static void provide(std::shared_ptr<SpriteSheetCache> service) {
+        spriteSheetService = service;
+    }
+
+    static std::shared_ptr<SpriteSheetCache> getSpriteSheets() {
+        return spriteSheetService;
+    }
+
+    static void provide(std::shared_ptr<AnimationSystem> service) {
+        animationService = service;
+    }
+
+    static std::shared_ptr<AnimationSystem> getAnimations() {
+        return animationService;
+    }
+
+    static void provide(std::shared_ptr<ParticleSystem> service) {
+        particleService = service;
+    }
+
+    static std::shared_ptr<ParticleSystem> getParticles() {
+        return particleService;
+    }
+
+    static void provide(std::shared_ptr<EventBus> service) {
+        eventService = service;
+    }
+
+    static std::shared_ptr<EventBus> getEvents() {
+        return eventService;
+    }
+
+    static void provide(std::shared_ptr<RenderStore> service) {
+        renderService = service;
+    }
+
+    static std::shared_ptr<RenderStore> getRenderStore() {
+        return renderService;
+    }
+
 private:
     static std::shared_ptr<AudioManager> audioService;
+    static std::shared_ptr<AssetLoader> assetService;
+    static std::shared_ptr<TextureCache> textureService;
+    static std::shared_ptr<SpriteSheetCache> spriteSheetService;
+    static std::shared_ptr<AnimationSystem> animationService;
+    static std::shared_ptr<ParticleSystem> particleService;
+    static std::shared_ptr<EventBus> eventService;
+    static std::shared_ptr<RenderStore> renderService;
 };
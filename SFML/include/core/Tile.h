@@ -4,20 +4,26 @@
 #include <memory>
 
 class TileTexture;
+class RenderCommandList;
 
 enum class TileType { CORRIDOR, WALL };
 
+// Flyweight shared by every cell with the same type and texture. The board
+// only stores a one-byte code per cell; positions come from the cell index.
 class Tile {
 public:
-    Tile(TileType t);
+    Tile(TileType t, std::shared_ptr<TileTexture> sharedTex, float scale);
 
-    void loadTile(int x, int y, float scale, std::shared_ptr<TileTexture> sharedTex);
-    void draw(class Window* window);
+    void draw(RenderCommandList& commands, int x, int y) const;
     TileType getType() const { return type; }
+    // Side of one cell in world units.
+    float getSize() const { return size; }
+    float getScale() const { return scale.x; }
 
 private:
     TileType type;
-    sf::Vector2i position;
-    sf::Sprite sprite;
     std::shared_ptr<TileTexture> texture; //Flyweight: shared texture
+    sf::IntRect textureRect;
+    sf::Vector2f scale;
+    float size;
 };
@@ -0,0 +1,61 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <SFML/System/Clock.hpp>
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "AudioSink.h"
+#include "AssetLoader.h"
+#include "../../include/utils/MemoryTracker.h"
+
+// Plays sounds on a fixed pool of voices. A free voice is used when there is
+// one; otherwise the lowest-priority (then oldest) voice is stolen, but only
+// from a sound of equal or lower priority. Triggers of the same sound within
+// its cooldown are collapsed into the one already playing.
+class VoicePoolSink : public AudioSink {
+public:
+    static const size_t maxVoices = 16;
+
+    // With an AssetLoader, loadSound only queues the decode; buffers are
+    // attached by finishLoading() or on first play.
+    explicit VoicePoolSink(std::shared_ptr<AssetLoader> loader = nullptr);
+
+    // Throws if name hashes to the ID of a different, already loaded sound.
+    SoundID loadSound(const std::string& name, const std::string& filepath, const SoundSettings& settings) override;
+    void finishLoading() override;
+    void play(SoundID id) override;
+    void stop(SoundID id) override;
+    void stopAll() override;
+
+    size_t getActiveVoices() const;
+
+private:
+    struct SoundEntry {
+        std::string name;
+        std::string file;
+        std::shared_ptr<const sf::SoundBuffer> buffer;
+        // Decoded samples, charged to MemoryTag::Audio while the entry holds the buffer.
+        std::shared_ptr<MemoryCharge> memory;
+        AssetLoader::SoundHandle pending;
+        SoundSettings settings;
+        float lastPlayed;
+    };
+
+    struct Voice {
+        sf::Sound sound;
+        SoundID id = 0;
+        int priority = 0;
+        float startTime = 0.f;
+    };
+
+    void resolve(SoundEntry& entry);
+    static void setBuffer(SoundEntry& entry, std::shared_ptr<const sf::SoundBuffer> buffer);
+    Voice* pickVoice(int priority);
+
+    std::shared_ptr<AssetLoader> loader;
+    std::vector<SoundEntry> sounds;
+    std::unordered_map<SoundID, size_t> soundIndex;
+    std::array<Voice, maxVoices> voices;
+    sf::Clock clock;
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include "Entity.h"
+#include <memory>
+#include <vector>
+#include "../../include/components/VelocityComponent.h"
+#include "../../include/core/PathPlanner.h"
+
+// Hostile agent that chases the player by following the game's shared flow
+// field. When the player cannot be reached it wanders to random nearby cells
+// using individual paths from the game's PathPlanner.
+class Enemy : public Entity {
+public:
+    const float speed = 100.f;
+    // Wander destinations are picked within this many tiles.
+    const int wanderRange = 8;
+    // Seconds to wait before picking another destination.
+    const float wanderPause = 1.f;
+
+    Enemy();
+    ~Enemy();
+
+    void init(const std::string& textureFile, float scale) override;
+    void update(Game* game, float elapsed = 1.0f) override;
+
+    std::shared_ptr<VelocityComponent> getVelocityComp() const { return velocity; }
+
+private:
+    void wander(Game* game, int col, int row, float elapsed);
+    void steerTo(float tileSize, int col, int row);
+
+    std::shared_ptr<VelocityComponent> velocity;
+
+    PathRequestID pathRequest;
+    std::vector<sf::Vector2i> path;
+    size_t pathIndex;
+    float wanderDelay;
+    unsigned int wanderSeed;
+};
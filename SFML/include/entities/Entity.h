@@ -1,36 +1,53 @@
 #pragma once
-#include "../../include/graphics/Window.h"
-#include "../../include/graphics/SpriteSheet.h"
+#include "../../include/graphics/RenderStore.h"
+#include "../../include/graphics/RenderCommands.h"
 #include "../../include/utils/Rectangle.h"
 #include "../../include/components/PositionComponent.h"
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include <SFML/System/Vector2.hpp>
 #include "../../include/utils/Bitmask.h"
+#include "../../include/utils/MemoryTracker.h"
 
 using EntityID = unsigned int;
 class Game;
 class Component;
 class TTLComponent;
 
+// Events an entity can schedule on the game's timer wheel.
+enum class EntityTimer {
+    EXPIRE,             // Handled by the game: deletes the entity.
+    SHOOT_COOLDOWN
+};
+
 enum class EntityType {
     UNDEFINED = -1,
     PLAYER = 0,
     POTION = 1,
     LOG = 2,
-    FIRE = 3
+    FIRE = 3,
+    ENEMY = 4
 };
 
-class Entity {
+// Simulation side of a game object: type, position, bounding box and
+// components. What it looks like lives in the RenderStore behind a handle.
+class Entity : public std::enable_shared_from_this<Entity> {
 public:
     Entity();
     Entity(EntityType et);
     virtual ~Entity();
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
 
     virtual void init(const std::string& textureFile, float scale);
     virtual void initSpriteSheet(const std::string& spriteSheetFile);
+    // Hot reload: moves the sprite sheet onto newDef if it currently uses oldDef.
+    virtual void reloadSpriteSheet(const SpriteSheetDef* oldDef, std::shared_ptr<const SpriteSheetDef> newDef);
     virtual void update(Game* game, float elapsed);
-    virtual void draw(Window* window);
+    // Appends this entity's sprite and debug outline to the frame's commands.
+    virtual void draw(RenderCommandList& commands) const;
 
     void setID(EntityID entId) { id = entId; }
     EntityID getID() const { return id; }
@@ -43,7 +60,8 @@ public:
     sf::Vector2f getSpriteScale() const;
 
     Rectangle& getBoundingBox() { return boundingBox; }
-    const SpriteSheet* getSpriteSheet() const { return &spriteSheet; }
+    // nullptr unless initialised with initSpriteSheet.
+    const SpriteSheet* getSpriteSheet() const;
     EntityType getEntityType() const { return type; }
 
     bool isDeleted() const { return deleted; }
@@ -56,15 +74,20 @@ public:
 
     void addComponent(std::shared_ptr<Component> component) {
         ComponentID id = component->getID();
+        if (componentSet.getBit(static_cast<unsigned int>(id))) {
+            for (auto& entry : components)
+                if (entry.first == id) entry.second = component;
+            return;
+        }
         componentSet.turnOnBit(static_cast<unsigned int>(id));
-        components[id] = component;
+        components.emplace_back(id, component);
     }
 
     std::shared_ptr<Component> getComponent(ComponentID id) const {
-        auto found = components.find(id);
-        if (found != components.end()) {
-            return found->second;
-        }
+        // A handful of components per entity: a linear scan beats hashing.
+        if (!componentSet.getBit(static_cast<unsigned int>(id))) return nullptr;
+        for (const auto& entry : components)
+            if (entry.first == id) return entry.second;
         return nullptr;
     }
 
@@ -73,18 +96,21 @@ public:
     }
 
     virtual std::shared_ptr<TTLComponent> getTTLComponent() const { return nullptr; }
+    // Called when a timer this entity scheduled fires (except EXPIRE).
+    virtual void onTimer(EntityTimer) {}
 
 protected:
+    // The animated sheet in the RenderStore, for subclasses driving animations.
+    SpriteSheet* getRenderSheet();
+    void releaseRender();
+
     EntityType type;
     EntityID id;
     std::shared_ptr<PositionComponent> positionComp;
     Rectangle boundingBox;
     sf::Vector2f bboxSize;
-    bool isSpriteSheet;
-    SpriteSheet spriteSheet;
-    sf::Texture texture;
-    sf::Sprite sprite;
+    RenderHandle render;
     bool deleted;
     Bitmask componentSet;
-    std::unordered_map<ComponentID, std::shared_ptr<Component>> components;
+    std::vector<std::pair<ComponentID, std::shared_ptr<Component>>> components;
 };
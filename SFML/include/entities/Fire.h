@@ -3,31 +3,44 @@
 #include <memory>
 #include "../../include/components/TTLComponent.h"
 #include "../../include/components/VelocityComponent.h"
+#include "../../include/systems/ParticleSystem.h"
 
 class Fire : public Entity {
 public:
-    // The starting time-to-live for a Fire object (in frames).
-    const int startTimeToLive = 150;
+    // Seconds a Fire object lives for.
+    const float startTimeToLive = 2.5f;
+    // Matches the asset's case, which matters off Windows.
+    static constexpr const char* textureFile = "img/Fire.png";
 
     Fire();
     ~Fire();
 
-    // Update the Fire: update its position via its VelocityComponent, update the TTL,
-    // and mark for deletion if its TTL reaches 0.
+    // Update the Fire: update its position via its VelocityComponent. Expiry
+    // is driven by the game's timer wheel through the TTL component.
     void update(Game* game, float elapsed = 1.0f) override;
 
-    // Return the current TTL value.
-    int getTTL() const { return ttl ? ttl->getTTL() : 0; }
+    float getLifetime() const { return ttl ? ttl->getLifetime() : 0.f; }
 
     // Return the shared pointer to the VelocityComponent.
     std::shared_ptr<VelocityComponent> getVelocityComp() const { return velocity; }
 
     std::shared_ptr<TTLComponent> getTTLComponent() const override;
 
+    // Brings a pooled fire back to life; see FirePool.
+    void respawn(const sf::Vector2f& position, const sf::Vector2f& vel);
+    int getPoolSlot() const { return poolSlot; }
+    void setPoolSlot(int slot) { poolSlot = slot; }
+    // Particle emitter following this fire, detached when it is pooled again.
+    ParticleSystem::EmitterHandle getTrail() const { return trail; }
+    void setTrail(ParticleSystem::EmitterHandle handle) { trail = handle; }
+
 private:
-    // The TTL component handles the time-to-live logic.
+    // The TTL component holds the lifetime and its expiry timer.
     std::shared_ptr<TTLComponent> ttl;
 
     // The Velocity component handles movement.
     std::shared_ptr<VelocityComponent> velocity;
+
+    int poolSlot;
+    ParticleSystem::EmitterHandle trail;
 };
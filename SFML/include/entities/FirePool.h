@@ -0,0 +1,28 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+#include "Fire.h"
+
+// Preallocated Fire projectiles. Fires are built once, texture and
+// components included; acquire() only resets a dormant one's position,
+// velocity and TTL, and release() hands it back when the game drops it.
+// A recycled fire keeps its entity ID. The pool grows by one fire when it
+// runs dry, so reserve for the expected peak.
+class FirePool {
+public:
+    void reserve(size_t count);
+
+    std::shared_ptr<Fire> acquire(const sf::Vector2f& position, const sf::Vector2f& velocity);
+    // For fires the game has just removed; anything else is ignored.
+    void release(Fire* fire);
+
+    size_t size() const { return fires.size(); }
+    size_t getAvailable() const { return freeSlots.size(); }
+
+private:
+    void grow();
+
+    std::vector<std::shared_ptr<Fire>> fires;
+    std::vector<int> freeSlots;
+};
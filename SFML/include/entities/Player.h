@@ -3,7 +3,6 @@
 #include "../../include/components/HealthComponent.h"
 #include "../../include/components/VelocityComponent.h"
 #include <memory>
-#include "../../include/utils/Observer.h"
 
 class InputComponent;
 class Fire;
@@ -27,11 +26,13 @@ public:
     // Overridden initialization functions.
     void init(const std::string& textureFile, float scale) override;
     void initSpriteSheet(const std::string& spriteSheetFile) override;
+    void reloadSpriteSheet(const SpriteSheetDef* oldDef, std::shared_ptr<const SpriteSheetDef> newDef) override;
     // Update and draw functions.
     void update(Game* game, float elapsed) override;
-    void draw(Window* window) override;
+    void draw(RenderCommandList& commands) const override;
     // Input handling.
     void handleInput(Game& game);
+    void onTimer(EntityTimer event) override;
 
     // Getters for state.
     bool isAttacking() const { return attacking; }
@@ -49,19 +50,25 @@ public:
     // Position the sprite in the tile map.
     void positionSprite(int row, int col, int spriteWH, float tileScale);
 
-    void setObserver(std::shared_ptr<Observer> obs);
-    std::shared_ptr<Observer> getObserver() const;
-
 private:
-    std::shared_ptr<Fire> createFire() const;
-    std::shared_ptr<Observer> observer;
+    std::shared_ptr<Fire> createFire(Game& game) const;
+    void resolveAnimations();
 
     bool attacking;
     bool shouting;
     std::shared_ptr<HealthComponent> healthComp;
     int wood;
-    float shootCooldown;
+    // Cleared on shooting; a timer sets it again after shootCooldownTime.
+    bool shootReady;
+    // Lives in the RenderStore; set by initSpriteSheet.
+    SpriteSheet* spriteSheet;
     std::shared_ptr<InputComponent> input;
     std::shared_ptr<VelocityComponent> velocity;
 
+    // Animation IDs resolved once when the sprite sheet is loaded.
+    AnimID idleAnim;
+    AnimID walkAnim;
+    AnimID attackAnim;
+    AnimID shoutAnim;
+
 };
@@ -1,25 +1,21 @@
 #pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
 #include <sstream>
+#include <string>
+#include <vector>
 
-class SpriteSheet;
-
+// Definition of one animation as read from a sprite sheet file. Playback
+// state lives in the AnimationSystem; this class only describes the clip and
+// compiles its frame rects once at load time.
 class AnimBase
 {
-	friend class SpriteSheet;
-
 public:
 	AnimBase();
 	virtual ~AnimBase();
 
-	void setSpriteSheet(SpriteSheet* ss) { spriteSheet = ss; }
-	void setLooping(bool l) { loop = l; }
 	void setName(const std::string& n) { name = n; }
- 	void setFrame(int fr);
-	bool isInAction();
-	bool isPlaying() const { return playing; }
-	bool isLooping() const { return loop; }
 
-	int getCurrentFrame() const { return curFrame; }
 	int getStartFrame() const { return startFrame; }
 	int getEndFrame() const { return endFrame; }
 	int getFrameRow() const { return frameRow; }
@@ -27,14 +23,15 @@ public:
 	int getFrameActionStart() const { return frameActionStart; }
 	int getFrameActionEnd() const { return frameActionEnd; }
 
-	const std::string& getName() const { return name; }
+	// Number of frames played, in either direction.
+	int getFrameCount() const;
+	// Position in play order of a sheet column, or -1 if it is outside the clip.
+	int toPlayIndex(int column) const;
 
-	void play();
-	void pause();
-	void stop();
-	void reset();
+	const std::string& getName() const { return name; }
 
-	virtual void update(float elapsedTime);
+	// Appends getFrameCount() rects per direction, in play order.
+	virtual void buildFrames(const sf::Vector2i& spriteSize, size_t numAnimations, std::vector<sf::IntRect>& out) const = 0;
 
 	friend std::stringstream& operator >>(std::stringstream& st, AnimBase& a)
 	{
@@ -44,11 +41,8 @@ public:
 
 protected:
 
-	virtual void frameStep() = 0;
-	virtual void cropSprite() = 0;
 	virtual void readIn(std::stringstream& ss) = 0;
 
-	int curFrame;
 	int startFrame;
 	int endFrame;
 	int frameRow;
@@ -56,11 +50,6 @@ protected:
 	int frameActionStart;
 	int frameActionEnd;
 	float frameTime;
-	float elapsedTime;
-	bool loop;
-	bool playing;
 
 	std::string name;
-	SpriteSheet* spriteSheet;
 };
-
@@ -3,9 +3,12 @@
 
 class AnimDirectional : public AnimBase
 {
+public:
+	// Rows for the Left direction follow all the Right rows in the sheet.
+	static const int numDirections = 2;
+
+	void buildFrames(const sf::Vector2i& spriteSize, size_t numAnimations, std::vector<sf::IntRect>& out) const override;
+
 protected:
-	void frameStep();
-	void cropSprite();
-	void readIn(std::stringstream& st);
+	void readIn(std::stringstream& st) override;
 };
-
@@ -0,0 +1,24 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "../../include/utils/Rectangle.h"
+
+// Follows a target point and keeps the view inside the world bounds.
+class Camera {
+public:
+    Camera();
+
+    void setViewSize(const sf::Vector2f& size);
+    void setWorldSize(const sf::Vector2f& size);
+    void follow(const sf::Vector2f& target);
+
+    const sf::View& getView() const { return view; }
+    // World-space rectangle currently covered by the view.
+    Rectangle getViewRect() const;
+
+private:
+    float clampAxis(float target, float viewExtent, float worldExtent) const;
+
+    sf::View view;
+    sf::Vector2f viewSize;
+    sf::Vector2f worldSize;
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// Values shown by the HUD, copied out of the game each frame.
+struct HudState {
+    int fps = 0;
+    int health = 0;
+    int maxHealth = 0;
+    int wood = 0;
+    int memoryKiB = 0;          // Tracked total, see MemoryTracker
+    int memoryBudgetKiB = -1;   // -1 when there is no total budget
+    bool hasPlayer = false;
+    bool paused = false;
+};
+
+// A single HUD element holding its own text. The glyph geometry is rebuilt
+// only when the bound value changes.
+class HudWidget {
+public:
+    HudWidget();
+
+    void setup(const sf::Font& font, unsigned int size, const sf::Color& color, const std::string& lbl);
+    void setPosition(float x, float y) { text.setPosition(x, y); }
+
+    // Each setter returns true if the widget changed and the HUD must be recomposed.
+    bool setValue(int value, int maxValue = -1);
+    bool setVisible(bool v);
+
+    bool isVisible() const { return visible; }
+    void draw(sf::RenderTarget& target) const;
+
+private:
+    sf::Text text;
+    std::string label;
+    char buffer[64];
+    int lastValue;
+    int lastMax;
+    bool built;
+    bool visible;
+};
+
+// Retained HUD layer. Widgets are composited into a cached render texture
+// that is redrawn only when one of them changes. The FPS and memory readouts
+// move almost every frame, so they are sampled only every readoutInterval.
+class Hud {
+public:
+    Hud();
+
+    void init(const sf::Font& font, unsigned int fontSize);
+    void resize(const sf::Vector2u& size);
+    void update(const HudState& state);
+    void draw(sf::RenderTarget& target);
+
+private:
+    void compose();
+
+    HudWidget fpsWidget;
+    HudWidget healthWidget;
+    HudWidget woodWidget;
+    HudWidget memoryWidget;
+    HudWidget pausedWidget;
+
+    sf::RenderTexture cache;
+    sf::Sprite cacheSprite;
+    sf::Clock readoutClock;
+    bool ready;
+    bool dirty;
+    bool readoutsDue;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include "RenderBackend.h"
+#include <fstream>
+#include <string>
+
+// Headless backend: draws nothing and writes one CSV row of statistics per
+// frame. Batching mirrors Window::submit, so the draw call and vertex counts
+// are the ones the SFML backend would issue. Each row ends with the memory
+// every subsystem holds (KiB, as reported by MemoryTracker), total last; the
+// closing total row has the peaks instead. Game calls record() on the
+// simulation thread, so the memory read is that of the frame's own tick.
+class RecordingRenderBackend : public RenderBackend {
+public:
+    struct FrameStats {
+        unsigned int commands = 0;
+        unsigned int drawCalls = 0;
+        unsigned int vertices = 0;
+        unsigned int textureChanges = 0;
+        unsigned int viewChanges = 0;
+        unsigned int quads = 0;
+        unsigned int rects = 0;
+    };
+
+    explicit RecordingRenderBackend(const std::string& file);
+    ~RecordingRenderBackend() override;
+
+    void beginFrame() override;
+    void submit(const RenderCommandList& commands) override;
+    void endFrame() override;
+    // One whole frame, written as row frame.
+    void record(unsigned long frame, const RenderCommandList& commands);
+
+    const FrameStats& getLastFrame() const { return last; }
+    unsigned int getFrameCount() const { return frameCount; }
+
+private:
+    void flush();
+    void writeFrame(unsigned long frame);
+
+    std::ofstream out;
+    FrameStats current;
+    FrameStats last;
+    FrameStats totals;
+    unsigned int frameCount;
+
+    // Pending batch, as Window would hold it.
+    const CachedTexture* batchTexture;
+    unsigned int batchVertices;
+};
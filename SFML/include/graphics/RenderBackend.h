@@ -0,0 +1,16 @@
+#pragma once
+#include "RenderCommands.h"
+
+// Executes RenderCommandLists. Window is the SFML implementation;
+// RecordingRenderBackend only measures what would have been drawn.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual void beginFrame() = 0;
+    virtual void submit(const RenderCommandList& commands) = 0;
+    virtual void endFrame() = 0;
+
+    // Called on the thread that is about to (stop to) submit frames.
+    virtual void setActive(bool /*active*/) {}
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Hud.h"
+#include "../../include/utils/Rectangle.h"
+
+class CachedTexture;
+
+enum class RenderCommandType { View, Quad, Rect, Hud, Vertices };
+
+// One backend-agnostic draw command. Only the fields relevant to the type are used.
+struct RenderCommand {
+    RenderCommandType type;
+    const CachedTexture* texture;   // Quad, Vertices (nullptr for untextured)
+    sf::IntRect textureRect;        // Quad
+    sf::Vector2f position;          // Quad
+    sf::Vector2f scale;             // Quad
+    sf::FloatRect bounds;           // Rect
+    sf::Color color;                // Rect outline
+    float thickness;                // Rect outline
+    int viewIndex;                  // View: index passed to getView(), -1 for screen space
+    unsigned int firstVertex;       // Vertices: range in getVertices(), drawn as triangles
+    unsigned int vertexCount;       // Vertices
+};
+
+// Ordered list of draw commands describing one frame. Built on the simulation
+// thread and handed to a RenderBackend, so it only holds plain values and
+// pointers to textures that outlive the frame.
+class RenderCommandList {
+public:
+    void clear();
+
+    void setView(const sf::View& view);
+    void setScreenView();
+    void quad(const CachedTexture* texture, const sf::IntRect& textureRect,
+              const sf::Vector2f& position, const sf::Vector2f& scale);
+    void rect(const sf::FloatRect& bounds, const sf::Color& color, float thickness);
+    // Green debug outline around a bounding box.
+    void rect(const Rectangle& r);
+    void hud(const HudState& state);
+    // Prebuilt triangles drawn in one call: append to the returned vector,
+    // then call endVertices(). Empty batches are dropped.
+    std::vector<sf::Vertex>& beginVertices(const CachedTexture* texture);
+    void endVertices();
+
+    // Appends every command of another list, remapping its views.
+    void append(const RenderCommandList& other);
+
+    const std::vector<RenderCommand>& getCommands() const { return commands; }
+    const sf::View& getView(int index) const { return views[index]; }
+    const std::vector<sf::Vertex>& getVertices() const { return vertices; }
+    const HudState& getHudState() const { return hudState; }
+    bool empty() const { return commands.empty(); }
+
+private:
+    RenderCommand& push(RenderCommandType type);
+
+    std::vector<RenderCommand> commands;
+    std::vector<sf::View> views;
+    std::vector<sf::Vertex> vertices;
+    HudState hudState;
+};
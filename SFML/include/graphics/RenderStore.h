@@ -0,0 +1,57 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "SpriteSheet.h"
+#include "RenderCommands.h"
+#include "../../include/utils/MemoryTracker.h"
+
+using RenderHandle = int;
+
+// Render-side data of entities, kept out of the simulation objects. An
+// entity holds only a handle; its texture, scale and, for animated
+// entities, the sprite sheet live here and are read only when the entity
+// is drawn. Static sprites need no sf::Sprite at all: draw() emits a quad
+// straight from the texture and the entity's position. Slots and sprite
+// sheets are charged to MemoryTag::Entities, as they belong to entities.
+class RenderStore {
+public:
+    static const RenderHandle InvalidHandle = -1;
+
+    RenderStore() : sheetCount(0), memory(MemoryTag::Entities) {}
+
+    RenderHandle addTexture(std::shared_ptr<const CachedTexture> texture, float scale);
+    // Loads the sheet and starts its "Idle" animation.
+    RenderHandle addSpriteSheet(const std::string& file);
+    void release(RenderHandle h);
+
+    // Unscaled size of one sprite.
+    sf::Vector2i getTextureSize(RenderHandle h) const;
+    sf::Vector2f getScale(RenderHandle h) const;
+    // Size drawn on screen, i.e. texture size times scale.
+    sf::Vector2f getSize(RenderHandle h) const;
+    // nullptr for handles without a sprite sheet.
+    SpriteSheet* getSpriteSheet(RenderHandle h) { return slots[h].sheet.get(); }
+    const SpriteSheet* getSpriteSheet(RenderHandle h) const { return slots[h].sheet.get(); }
+
+    void draw(RenderHandle h, const sf::Vector2f& position, RenderCommandList& commands);
+
+    size_t size() const { return slots.size() - freeSlots.size(); }
+
+private:
+    struct Slot {
+        std::shared_ptr<const CachedTexture> texture;
+        sf::Vector2f scale;
+        // Heap-allocated so its sprite stays put for the AnimationSystem.
+        std::unique_ptr<SpriteSheet> sheet;
+    };
+
+    RenderHandle allocate();
+    void updateCharge();
+
+    std::vector<Slot> slots;
+    std::vector<RenderHandle> freeSlots;
+    size_t sheetCount;
+    MemoryCharge memory;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include "RenderBackend.h"
+#include "../../include/utils/TripleBuffer.h"
+
+// Submits published RenderCommandLists to a RenderBackend on its own thread
+// so simulation and presentation overlap. For the SFML backend the window's
+// GL context is owned by this thread while it runs; events are still polled
+// on the main thread.
+class RenderThread {
+public:
+    RenderThread();
+    ~RenderThread();
+
+    void setBackend(RenderBackend* b) { backend = b; }
+
+    void start();
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Simulation side: fill the write list, then publish it.
+    RenderCommandList& getWriteList() { return buffer.writeBuffer(); }
+    void publish() { buffer.publish(); }
+
+private:
+    void run();
+
+    RenderBackend* backend;
+    TripleBuffer<RenderCommandList> buffer;
+    std::thread thread;
+    std::atomic<bool> running;
+};
@@ -1,47 +1,63 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <unordered_map>
-#include "AnimBase.h"
-
-using Animations = std::unordered_map<std::string, AnimBase*>;
-enum class Direction { Right = 0, Left };
-
+#include <memory>
+#include "SpriteSheetDef.h"
+#include "RenderCommands.h"
+#include "../../include/systems/AnimationSystem.h"
+
+// Per-entity view of a shared SpriteSheetDef: only the sprite, facing
+// direction, current animation and its playback slot are held here. The
+// sprite carries position, scale and frame rect only; the texture is the
+// definition's and goes into render commands, so it works headless too.
 class SpriteSheet {
 public:
+    static const AnimID NoAnimation = SpriteSheetDef::NoAnimation;
+
     SpriteSheet();
     ~SpriteSheet();
+    SpriteSheet(const SpriteSheet&) = delete;
+    SpriteSheet& operator=(const SpriteSheet&) = delete;
 
     void releaseSheet();
-    void setSpriteSize(const sf::Vector2i& size);
     void setSpriteScale(const sf::Vector2f& scale);
     void setSpritePosition(const sf::Vector2f& pos);
     void setSpriteDirection(const Direction& dir);
 
-    const sf::Vector2i& getSpriteSize() const { return spriteSize; }
+    const sf::Vector2i& getSpriteSize() const { return def ? def->getSpriteSize() : noSize; }
     const sf::Vector2f& getSpriteScale() const { return spriteScale; }
     const Direction& getSpriteDirection() const { return direction; }
     const sf::Vector2f& getSpritePosition() const { return sprite.getPosition(); }
-    const std::string& getAnimType() const { return animType; }
-    size_t getNumAnimations() const { return animations.size(); }
+    size_t getNumAnimations() const { return def ? def->getNumAnimations() : 0; }
+    const SpriteSheetDef* getDefinition() const { return def.get(); }
     sf::Sprite& getSprite() { return sprite; }
+    const sf::Sprite& getSprite() const { return sprite; }
 
     void cropSprite(const sf::IntRect& rect);
+    // Attaches the shared definition for file, loading it on first use.
     bool loadSheet(const std::string& file);
+    // Switches to a reloaded definition, keeping the current animation by name.
+    void rebind(std::shared_ptr<const SpriteSheetDef> newDef);
 
-    AnimBase* getCurrentAnim() const;
+    // Resolve names once and keep the ID; setAnimation(AnimID) does no lookups.
+    AnimID getAnimationID(const std::string& name) const;
+    AnimID getCurrentAnim() const { return curAnimation; }
 
+    bool setAnimation(AnimID id, bool play = false, bool loop = false);
     bool setAnimation(const std::string& name, bool play = false, bool loop = false);
 
-    void update(float elapsedTime);
-    void draw(sf::RenderWindow* window);
+    // State of the current animation, as advanced by the AnimationSystem.
+    bool isPlaying() const;
+    bool isInAction() const;
+
+    void draw(RenderCommandList& commands) const;
 
 private:
-    sf::Texture texture;
+    static const sf::Vector2i noSize;
+
+    std::shared_ptr<const SpriteSheetDef> def;
     sf::Sprite sprite;
-    sf::Vector2i spriteSize;
     sf::Vector2f spriteScale;
     Direction direction;
-    std::string animType;
-    Animations animations;
-    AnimBase* curAnimation;
+    AnimID curAnimation;
+    AnimationSystem::Handle animHandle;
 };
@@ -0,0 +1,22 @@
+#pragma once
+#include "SpriteSheetDef.h"
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Flyweight store of sprite sheet definitions, keyed by file name.
+class SpriteSheetCache {
+public:
+    std::shared_ptr<const SpriteSheetDef> get(const std::string& file);
+    // Re-parses a cached sheet and replaces the entry. Sheets already handed
+    // out keep the old definition until they are rebound. Throws on parse errors.
+    std::shared_ptr<const SpriteSheetDef> reload(const std::string& file);
+    bool contains(const std::string& file);
+    std::vector<std::string> getFiles();
+
+private:
+    std::mutex mtx;
+    std::unordered_map<std::string, std::shared_ptr<const SpriteSheetDef>> sheets;
+};
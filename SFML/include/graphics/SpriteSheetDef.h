@@ -0,0 +1,69 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../include/utils/MemoryTracker.h"
+
+class CachedTexture;
+
+// Interned animation name; index into the sheet's animation list.
+using AnimID = int;
+enum class Direction { Right = 0, Left };
+
+// Immutable definition of a sprite sheet, shared by every entity using it.
+// Parsed once from the text format and cached next to it as a compact binary
+// file so later runs skip parsing entirely.
+class SpriteSheetDef {
+public:
+    static const AnimID NoAnimation = -1;
+    static const int numDirections = 2;
+
+    // Frame table of one animation, compiled at load time.
+    struct AnimClip {
+        int firstRect;      // offset in the rect table of the Right-facing frames
+        int frameCount;     // frames per direction
+        float frameTime;
+        int actionFirst;    // play-order range of action frames,
+        int actionLast;     // -1 when the whole clip counts as in action
+    };
+
+    SpriteSheetDef() : spriteScale(1.f, 1.f), memory(MemoryTag::SpriteSheets) {}
+
+    // Loads from the binary cache when it is up to date, else parses the text
+    // file and refreshes the cache. forceText skips the cache (hot reload).
+    static std::shared_ptr<const SpriteSheetDef> load(const std::string& file, bool forceText = false);
+
+    const CachedTexture* getTexture() const { return texture.get(); }
+    const std::string& getTextureFile() const { return textureFile; }
+    const sf::Vector2i& getSpriteSize() const { return spriteSize; }
+    const sf::Vector2f& getSpriteScale() const { return spriteScale; }
+    const std::string& getAnimType() const { return animType; }
+    size_t getNumAnimations() const { return clips.size(); }
+
+    AnimID getAnimationID(const std::string& name) const;
+    const std::string& getAnimationName(AnimID id) const { return names[id]; }
+    const AnimClip& getClip(AnimID id) const { return clips[id]; }
+    const sf::IntRect* getFrames(AnimID id, Direction dir) const;
+
+    static std::string cacheFileFor(const std::string& file);
+
+private:
+    void readText(const std::string& file);
+    bool readBinary(const std::string& file);
+    void writeBinary(const std::string& file) const;
+    void finishLoad();
+
+    std::shared_ptr<const CachedTexture> texture;
+    std::string textureFile;
+    sf::Vector2i spriteSize;
+    sf::Vector2f spriteScale;
+    std::string animType;
+
+    std::vector<std::string> names;
+    std::unordered_map<std::string, AnimID> animationIDs;
+    std::vector<AnimClip> clips;
+    std::vector<sf::IntRect> frameRects;
+    MemoryCharge memory;
+};
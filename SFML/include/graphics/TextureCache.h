@@ -0,0 +1,59 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../../include/core/AssetLoader.h"
+#include "../../include/utils/MemoryTracker.h"
+
+// A texture as handed out by the TextureCache, and what render commands
+// refer to. Constructing any sf::Texture creates SFML's shared GL context,
+// so headless runs only know the size and getTexture() returns nullptr;
+// only backends that really draw ask for it.
+class CachedTexture {
+public:
+    const sf::Texture* getTexture() const { return texture.get(); }
+    const sf::Vector2u& getSize() const { return size; }
+
+private:
+    friend class TextureCache;
+    std::unique_ptr<sf::Texture> texture;
+    sf::Vector2u size;
+};
+
+// Flyweight store for entity, tile and sprite sheet textures. Textures stay
+// alive as long as the cache does, so render commands can refer to them by
+// pointer. With an AssetLoader, prefetch() starts decoding in the background
+// and get() only does the GPU upload, so it must be called on a thread that
+// may own GL resources (the main thread).
+// Without GPU upload (headless runs) images are only decoded for their size.
+class TextureCache {
+public:
+    explicit TextureCache(std::shared_ptr<AssetLoader> loader = nullptr, bool uploadToGpu = true);
+
+    void prefetch(const std::string& file);
+    std::shared_ptr<const CachedTexture> get(const std::string& file);
+    // Uploads every prefetched texture that nobody has asked for yet.
+    void finishLoading();
+
+    // Reloads a cached texture in place, so sprites and render commands
+    // holding it see the new pixels. Returns false if the file is not cached
+    // or fails to load, in which case the old texture is kept. Must not run
+    // while another thread is drawing with the texture.
+    bool reload(const std::string& file);
+    bool contains(const std::string& file);
+    std::vector<std::string> getFiles();
+
+private:
+    std::shared_ptr<const CachedTexture> upload(const std::string& file);
+    void charge(const std::string& file, const sf::Vector2u& size);
+
+    std::shared_ptr<AssetLoader> loader;
+    bool uploadToGpu;
+    std::mutex mtx;
+    std::unordered_map<std::string, std::shared_ptr<CachedTexture>> textures;
+    std::unordered_map<std::string, AssetLoader::ImageHandle> pending;
+    std::unordered_map<std::string, MemoryCharge> charges;
+};
@@ -1,16 +1,20 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <string>
+#include "../../include/core/ServiceLocator.h"
 
 class TileTexture {
 public:
+    // Shares the texture through the TextureCache, so prefetched tile images are reused.
     bool loadFromFile(const std::string& file) {
-        return texture.loadFromFile(file);
+        texture = ServiceLocator::getTextures()->get(file);
+        return texture != nullptr;
     }
 
-    const sf::Texture& getTexture() const { return texture; }
+    const CachedTexture* getTexture() const { return texture.get(); }
+    const sf::Vector2u& getSize() const { return texture->getSize(); }
 
 private:
-    sf::Texture texture;
+    std::shared_ptr<const CachedTexture> texture;
 };
-
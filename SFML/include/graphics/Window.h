@@ -1,29 +1,37 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <string>
-class Game;
+#include "Hud.h"
+#include "RenderBackend.h"
+#include "../../include/core/InputBuffer.h"
 
-class Window {
+// SFML render backend: owns the window, its events and the HUD layer.
+class Window : public RenderBackend {
 public:
     Window();
     ~Window();
 
     void loadFont(const std::string& fontFile);
-    void beginDraw();
-    void endDraw();
 
+    void beginFrame() override;
+    // Consecutive quads sharing a texture are batched into one draw call.
+    void submit(const RenderCommandList& commands) override;
+    void endFrame() override;
+    void setActive(bool active) override;
+
+    // Pumps window events; key transitions are queued in the input buffer.
     void update();
+    InputBuffer& getInput() { return input; }
+    // F5 toggles are deferred to the owner, which must release the render thread first.
+    bool consumeFullscreenToggle();
 
     bool isWindowDone() const;
     bool isWindowFullscreen() const;
     const sf::Vector2u& getWindowSize() const;
     const sf::Font& getGUIFont() const;
-    sf::Text& getFPSText();
 
     void toggleFullscreen();
-    void draw(sf::Drawable& drawable);
     void redraw();
-    void drawGUI(const Game& game);
 
     void setup(const std::string& title, const sf::Vector2u& size);
     inline void setTitle(const std::string& t) { windowTitle = t; }
@@ -34,15 +42,20 @@ private:
 
     void destroy();
     void create();
+    void flushBatch();
+    void appendQuad(const sf::FloatRect& area, const sf::IntRect& texRect, const sf::Color& color);
 
     sf::RenderWindow window;
     sf::Vector2u windowSize;
     std::string windowTitle;
     sf::Font guiFont;
-    sf::Text fpsText;
-    sf::Text pausedText;
-    sf::Text healthText;
+    Hud hud;
+    InputBuffer input;
+
+    sf::VertexArray batch;
+    const sf::Texture* batchTexture;
 
     bool isDone;
     bool isFullscreen;
+    bool fullscreenToggleRequested;
 };
@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstdint>
+
+// Advances every playing animation in one pass over structure-of-arrays
+// state. Each slot points at a precompiled frame-rect table and writes the
+// new rect into its sprite only when the frame actually changes.
+class AnimationSystem {
+public:
+    using Handle = int;
+    static const Handle InvalidHandle = -1;
+
+    Handle add(sf::Sprite* sprite);
+    void remove(Handle h);
+
+    // Starts a clip from its first frame. frames points at frameCount rects.
+    void play(Handle h, const sf::IntRect* frames, int frameCount, float frameTime, bool loop, bool playing);
+    // Swaps the rect table (e.g. on a direction change) keeping the current frame.
+    void setFrames(Handle h, const sf::IntRect* frames);
+    // Points a clip at a reloaded frame table, keeping its frame (clamped) and play state.
+    void retarget(Handle h, const sf::IntRect* frames, int frameCount, float frameTime);
+
+    int getFrame(Handle h) const { return frame[slotToDense[h]]; }
+    bool isPlaying(Handle h) const { return (flags[slotToDense[h]] & Playing) != 0; }
+
+    void update(float elapsed);
+
+    size_t size() const { return sprites.size(); }
+
+private:
+    enum Flags : uint8_t { Playing = 1, Looping = 2 };
+
+    // Dense SoA arrays, swap-removed.
+    std::vector<sf::Sprite*> sprites;
+    std::vector<const sf::IntRect*> frameTables;
+    std::vector<int> frameCount;
+    std::vector<int> frame;
+    std::vector<float> frameTime;
+    std::vector<float> elapsedTime;
+    std::vector<uint8_t> flags;
+
+    // Stable handles into the dense arrays.
+    std::vector<int> slotToDense;
+    std::vector<Handle> denseToSlot;
+    std::vector<Handle> freeSlots;
+};
@@ -21,12 +21,6 @@ public:
     }
 };
 
-class TTLSystem : public System {
-public:
-    TTLSystem();
-    void update(Game* game, Entity* entity, float elapsed) override;
-};
-
 class InputSystem : public System {
 public:
     InputSystem(); 
@@ -0,0 +1,128 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "ThreadPool.h"
+
+using SubscriptionID = std::uint32_t;
+
+// Typed, batched publish/subscribe. Each event type gets its own contiguous
+// queue, so publishing is a push_back with no virtual call or handler run.
+// dispatch() hands every subscriber the whole batch of its type published
+// since the last dispatch. Subscribers asked to run on the worker thread get
+// a shared, read-only copy of the batch and must not touch game state.
+// Publish, subscribe and dispatch are for the game thread only; events
+// published by handlers during dispatch go out with the next one.
+class EventBus {
+public:
+    enum class Delivery { GameThread, Worker };
+
+    EventBus() : nextID(1), worker(1) {}
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    template<typename E>
+    void publish(const E& event) {
+        channel<E>().pending.push_back(event);
+    }
+
+    template<typename E>
+    SubscriptionID subscribe(std::function<void(const std::vector<E>&)> handler, Delivery delivery = Delivery::GameThread) {
+        SubscriptionID id = nextID++;
+        channel<E>().subscribers.push_back({ id, std::move(handler), delivery });
+        return id;
+    }
+
+    void unsubscribe(SubscriptionID id) {
+        for (auto& ch : channels)
+            if (ch) ch->remove(id);
+    }
+
+    // Delivers every queued batch, type by type in first-use order.
+    void dispatch() {
+        for (size_t i = 0; i < channels.size(); i++)
+            if (channels[i]) channels[i]->dispatch(worker);
+    }
+
+    // Drops queued events without delivering them, e.g. on level restart.
+    void clear() {
+        for (auto& ch : channels)
+            if (ch) ch->clear();
+    }
+
+private:
+    struct ChannelBase {
+        virtual ~ChannelBase() = default;
+        virtual void dispatch(ThreadPool& worker) = 0;
+        virtual void remove(SubscriptionID id) = 0;
+        virtual void clear() = 0;
+    };
+
+    template<typename E>
+    struct Channel : ChannelBase {
+        struct Subscriber {
+            SubscriptionID id;
+            std::function<void(const std::vector<E>&)> handler;
+            Delivery delivery;
+        };
+
+        std::vector<E> pending, delivering;
+        std::vector<Subscriber> subscribers;
+
+        void dispatch(ThreadPool& worker) override {
+            if (pending.empty()) return;
+            // Swap first so the queue keeps its capacity and handlers can publish.
+            delivering.swap(pending);
+            pending.clear();
+
+            std::shared_ptr<const std::vector<E>> shared;
+            for (size_t i = 0; i < subscribers.size(); i++) {
+                if (subscribers[i].delivery == Delivery::GameThread) {
+                    subscribers[i].handler(delivering);
+                    continue;
+                }
+                if (!shared) shared = std::make_shared<const std::vector<E>>(delivering);
+                auto handler = subscribers[i].handler;
+                // One worker thread, so each subscriber sees its batches in order.
+                worker.submit([handler, shared] { handler(*shared); });
+            }
+            delivering.clear();
+        }
+
+        void remove(SubscriptionID id) override {
+            subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                [id](const Subscriber& s) { return s.id == id; }), subscribers.end());
+        }
+
+        void clear() override { pending.clear(); }
+    };
+
+    static size_t nextTypeIndex() {
+        static std::atomic<size_t> counter(0);
+        return counter++;
+    }
+
+    template<typename E>
+    static size_t typeIndex() {
+        static const size_t index = nextTypeIndex();
+        return index;
+    }
+
+    template<typename E>
+    Channel<E>& channel() {
+        size_t index = typeIndex<E>();
+        if (index >= channels.size()) channels.resize(index + 1);
+        if (!channels[index]) channels[index] = std::make_unique<Channel<E>>();
+        return static_cast<Channel<E>&>(*channels[index]);
+    }
+
+    std::vector<std::unique_ptr<ChannelBase>> channels;
+    SubscriptionID nextID;
+    // Declared last so it is joined before the channels go away.
+    ThreadPool worker;
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#ifndef __linux__
+#include <chrono>
+#include <filesystem>
+#endif
+
+// Reports files that were written since the last poll(). On Linux this uses
+// inotify on the containing directories, so edits saved through a rename are
+// caught as well; elsewhere it compares modification times, at most every
+// pollInterval. poll() never blocks and is meant to be called once a frame.
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Files are reported back with the same spelling they were watched with.
+    void watch(const std::string& file);
+    void poll(std::vector<std::string>& changed);
+
+private:
+#ifdef __linux__
+    int fd;
+    std::unordered_map<int, std::string> watchedDirs;       // watch descriptor -> directory
+    std::unordered_map<std::string, std::string> watched;   // directory/name -> watched spelling
+#else
+    static constexpr std::chrono::milliseconds pollInterval{ 500 };
+    std::unordered_map<std::string, std::filesystem::file_time_type> watched;
+    std::chrono::steady_clock::time_point lastPoll;
+#endif
+};
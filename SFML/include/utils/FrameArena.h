@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Linear (bump) allocator for data that lives for one tick. Allocation is a
+// pointer bump and nothing is freed individually; reset() drops everything
+// at once. When a frame outgrows the block, extra blocks are taken from the
+// heap and merged into one block of the frame's size at the next reset, so
+// the steady state never calls malloc. Not thread-safe: each thread uses
+// its own arena through local() and resets it at its own frame boundary.
+class FrameArena {
+public:
+    static const size_t defaultBlockSize = 256 * 1024;
+
+    explicit FrameArena(size_t blockSize = defaultBlockSize) : offset(0), frameBytes(0), highWater(0) {
+        blocks.push_back({ std::make_unique<unsigned char[]>(blockSize), blockSize });
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // alignment must be a power of two. It may exceed what new[] guarantees
+    // for the block, so the address is aligned rather than the offset.
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        Block& block = blocks.back();
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block.data.get()) + offset;
+        size_t start = offset + (static_cast<size_t>(0 - address) & (alignment - 1));
+        if (start + bytes > block.size) {
+            // Overflow: a new block big enough for this and then some.
+            size_t size = std::max(blocks.front().size, bytes + alignment);
+            frameBytes += block.size - offset;
+            blocks.push_back({ std::make_unique<unsigned char[]>(size), size });
+            offset = 0;
+            return allocate(bytes, alignment);
+        }
+        frameBytes += start + bytes - offset;
+        offset = start + bytes;
+        return blocks.back().data.get() + start;
+    }
+
+    template<typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Invalidates everything allocated since the last reset.
+    void reset() {
+        highWater = std::max(highWater, frameBytes);
+        if (blocks.size() > 1) {
+            size_t size = 0;
+            for (const Block& block : blocks) size += block.size;
+            blocks.clear();
+            blocks.push_back({ std::make_unique<unsigned char[]>(size), size });
+        }
+        offset = 0;
+        frameBytes = 0;
+    }
+
+    size_t getUsed() const { return frameBytes; }
+    size_t getCapacity() const {
+        size_t size = 0;
+        for (const Block& block : blocks) size += block.size;
+        return size;
+    }
+    // Largest amount used in any finished frame.
+    size_t getHighWater() const { return highWater; }
+
+    // The calling thread's arena.
+    static FrameArena& local() {
+        thread_local FrameArena arena;
+        return arena;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t offset;
+    size_t frameBytes;
+    size_t highWater;
+};
+
+// STL allocator drawing from a FrameArena; deallocate is a no-op. Containers
+// using it must not outlive the arena's next reset. Default-constructed
+// allocators use the calling thread's arena.
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept : arena(&FrameArena::local()) {}
+    explicit ArenaAllocator(FrameArena& a) noexcept : arena(&a) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.getArena()) {}
+
+    T* allocate(size_t n) { return arena->allocateArray<T>(n); }
+    void deallocate(T*, size_t) noexcept {}
+
+    FrameArena* getArena() const noexcept { return arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.getArena(); }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.getArena(); }
+
+private:
+    FrameArena* arena;
+};
+
+// Transient vector for the current tick; reserve up front, since growth
+// leaves the old storage in the arena until reset.
+template<typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
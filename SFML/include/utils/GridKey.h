@@ -0,0 +1,8 @@
+#pragma once
+
+// Packs a pair of grid coordinates into a single hash map key.
+using GridKey = long long;
+
+inline GridKey makeGridKey(int x, int y) {
+    return (static_cast<GridKey>(x) << 32) | static_cast<unsigned int>(y);
+}
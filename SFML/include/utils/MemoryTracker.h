@@ -0,0 +1,223 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Subsystems memory is charged to. Total is the sum of all of them.
+enum class MemoryTag : std::uint8_t {
+    Textures,       // Decoded pixels of every cached texture
+    SpriteSheets,   // Sprite sheet definitions (frame tables, clips, names)
+    Board,          // Tile chunks
+    Entities,
+    Components,
+    Audio,          // Decoded sound samples
+    Particles,
+    Total
+};
+
+struct MemoryStats {
+    size_t current = 0;
+    size_t peak = 0;
+    size_t count = 0;       // Live allocations (or objects) charged
+    size_t budget = 0;      // 0 when unbudgeted
+};
+
+// Process-wide accounting of the memory each subsystem holds. Owners report
+// what they allocate and free; the figures are atomics, so any thread may
+// report. Budgets are checked on the game thread once per tick: an overrun
+// either warns once (until usage drops back under) or throws.
+class MemoryTracker {
+public:
+    static const size_t tagCount = static_cast<size_t>(MemoryTag::Total) + 1;
+    enum class BudgetAction { Warn, Fail };
+
+    static void add(MemoryTag tag, size_t bytes) {
+        charge(slot(tag), bytes);
+        charge(slot(MemoryTag::Total), bytes);
+    }
+
+    static void remove(MemoryTag tag, size_t bytes) {
+        release(slot(tag), bytes);
+        release(slot(MemoryTag::Total), bytes);
+    }
+
+    static MemoryStats get(MemoryTag tag) {
+        const Slot& s = slot(tag);
+        MemoryStats stats;
+        stats.current = s.current.load(std::memory_order_relaxed);
+        stats.peak = s.peak.load(std::memory_order_relaxed);
+        stats.count = s.count.load(std::memory_order_relaxed);
+        stats.budget = s.budget.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // 0 bytes removes the budget.
+    static void setBudget(MemoryTag tag, size_t bytes, BudgetAction action = BudgetAction::Warn) {
+        Slot& s = slot(tag);
+        s.budget.store(bytes, std::memory_order_relaxed);
+        s.failOnOverrun.store(action == BudgetAction::Fail, std::memory_order_relaxed);
+        s.reported.store(false, std::memory_order_relaxed);
+    }
+
+    static void checkBudgets(std::ostream& log) {
+        for (size_t i = 0; i < tagCount; i++) {
+            MemoryTag tag = static_cast<MemoryTag>(i);
+            Slot& s = slot(tag);
+            size_t budget = s.budget.load(std::memory_order_relaxed);
+            if (budget == 0) continue;
+            size_t current = s.current.load(std::memory_order_relaxed);
+            if (current <= budget) {
+                s.reported.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            std::ostringstream msg;
+            msg << "Memory budget exceeded: " << getName(tag) << " uses " << toKiB(current)
+                << " KiB of " << toKiB(budget) << " KiB";
+            if (s.failOnOverrun.load(std::memory_order_relaxed))
+                throw std::runtime_error(msg.str());
+            if (!s.reported.exchange(true, std::memory_order_relaxed))
+                log << "[Memory] " << msg.str() << std::endl;
+        }
+    }
+
+    static const char* getName(MemoryTag tag) {
+        static const char* const names[tagCount] = {
+            "textures", "spritesheets", "board", "entities", "components", "audio", "particles", "total"
+        };
+        return names[static_cast<size_t>(tag)];
+    }
+
+    // Parses a subsystem name as printed by getName. Returns false if unknown.
+    static bool fromName(const std::string& name, MemoryTag& tag) {
+        for (size_t i = 0; i < tagCount; i++) {
+            if (name == getName(static_cast<MemoryTag>(i))) {
+                tag = static_cast<MemoryTag>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // One line per subsystem: current, peak, count and budget.
+    static void report(std::ostream& out) {
+        out << std::left << std::setw(14) << "subsystem" << std::right << std::setw(12) << "current_kib"
+            << std::setw(12) << "peak_kib" << std::setw(10) << "count" << std::setw(12) << "budget_kib" << '\n';
+        for (size_t i = 0; i < tagCount; i++) {
+            MemoryTag tag = static_cast<MemoryTag>(i);
+            MemoryStats stats = get(tag);
+            out << std::left << std::setw(14) << getName(tag) << std::right << std::setw(12) << toKiB(stats.current)
+                << std::setw(12) << toKiB(stats.peak) << std::setw(10) << stats.count << std::setw(12);
+            if (stats.budget) out << toKiB(stats.budget);
+            else out << '-';
+            out << '\n';
+        }
+    }
+
+    static size_t toKiB(size_t bytes) { return (bytes + 1023) / 1024; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> current{ 0 };
+        std::atomic<size_t> peak{ 0 };
+        std::atomic<size_t> count{ 0 };
+        std::atomic<size_t> budget{ 0 };
+        std::atomic<bool> failOnOverrun{ false };
+        std::atomic<bool> reported{ false };
+    };
+
+    static Slot& slot(MemoryTag tag) {
+        static Slot slots[tagCount];
+        return slots[static_cast<size_t>(tag)];
+    }
+
+    static void charge(Slot& s, size_t bytes) {
+        size_t now = s.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        s.count.fetch_add(1, std::memory_order_relaxed);
+        size_t peak = s.peak.load(std::memory_order_relaxed);
+        while (now > peak && !s.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+    }
+
+    static void release(Slot& s, size_t bytes) {
+        s.current.fetch_sub(bytes, std::memory_order_relaxed);
+        s.count.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+// Bytes charged to a tag for as long as the owner holds it, for memory that
+// is not allocated through a TrackingAllocator (pools, decoded assets).
+class MemoryCharge {
+public:
+    explicit MemoryCharge(MemoryTag t, size_t b = 0) : tag(t), bytes(0) { set(b); }
+    ~MemoryCharge() { set(0); }
+
+    MemoryCharge(MemoryCharge&& other) noexcept : tag(other.tag), bytes(other.bytes) { other.bytes = 0; }
+    MemoryCharge& operator=(MemoryCharge&& other) noexcept {
+        if (this != &other) {
+            set(0);
+            tag = other.tag;
+            bytes = other.bytes;
+            other.bytes = 0;
+        }
+        return *this;
+    }
+    MemoryCharge(const MemoryCharge&) = delete;
+    MemoryCharge& operator=(const MemoryCharge&) = delete;
+
+    void set(size_t b) {
+        if (b == bytes) return;
+        if (bytes) MemoryTracker::remove(tag, bytes);
+        bytes = b;
+        if (bytes) MemoryTracker::add(tag, bytes);
+    }
+    size_t get() const { return bytes; }
+
+private:
+    MemoryTag tag;
+    size_t bytes;
+};
+
+// STL allocator charging every allocation to a tag. With allocate_shared the
+// control block is charged too, so the figures are the real heap cost.
+template<typename T>
+class TrackingAllocator {
+public:
+    using value_type = T;
+
+    explicit TrackingAllocator(MemoryTag t) noexcept : tag(t) {}
+    template<typename U>
+    TrackingAllocator(const TrackingAllocator<U>& other) noexcept : tag(other.getTag()) {}
+
+    T* allocate(size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        MemoryTracker::add(tag, n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        MemoryTracker::remove(tag, n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    MemoryTag getTag() const noexcept { return tag; }
+
+    template<typename U>
+    bool operator==(const TrackingAllocator<U>& other) const noexcept { return tag == other.getTag(); }
+    template<typename U>
+    bool operator!=(const TrackingAllocator<U>& other) const noexcept { return tag != other.getTag(); }
+
+private:
+    MemoryTag tag;
+};
+
+// make_shared that charges the object (and its control block) to a tag.
+template<typename T, typename... Args>
+std::shared_ptr<T> makeTracked(MemoryTag tag, Args&&... args) {
+    return std::allocate_shared<T>(TrackingAllocator<T>(tag), std::forward<Args>(args)...);
+}
@@ -1,6 +1,5 @@
 #pragma once
 #include "Vector2.h"
-#include <SFML/Graphics.hpp>
 
 class Rectangle
 {
@@ -19,19 +18,8 @@ public:
 	const Vector2f& getTopLeft() const { return topLeft; }
 	const Vector2f& getBottomRight() const { return bottomRight; }
 
-	sf::RectangleShape& getDrawableRect()
-	{
-		drawableRect.setSize({ bottomRight.x - topLeft.x, bottomRight.y - topLeft.y });
-		drawableRect.setPosition(topLeft.x, topLeft.y);
-		drawableRect.setFillColor(sf::Color::Transparent);
-		drawableRect.setOutlineThickness(4);
-		drawableRect.setOutlineColor(sf::Color::Green);
-		return drawableRect;
-	}
-
 private:
 	Vector2f topLeft;
 	Vector2f bottomRight;
-	sf::RectangleShape drawableRect;
 };
 
@@ -0,0 +1,33 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+// Fixed-capacity FIFO with no allocations. Single-threaded; push fails when
+// the buffer is full so the caller decides what to drop.
+template<typename T, size_t N>
+class RingBuffer {
+    std::array<T, N> items;
+    size_t head = 0;
+    size_t count = 0;
+
+public:
+    bool push(const T& item) {
+        if (count == N) return false;
+        items[(head + count) % N] = item;
+        ++count;
+        return true;
+    }
+
+    bool pop(T& item) {
+        if (count == 0) return false;
+        item = items[head];
+        head = (head + 1) % N;
+        --count;
+        return true;
+    }
+
+    void clear() { head = 0; count = 0; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr size_t capacity() { return N; }
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include "Rectangle.h"
+#include "GridKey.h"
+
+// Uniform grid spatial index. Objects are bucketed by the cell holding the
+// top-left corner of their bounds, so objects must not be larger than a cell.
+template<typename T>
+class SpatialGrid {
+    using CellKey = GridKey;
+
+    float cellSize;
+    std::unordered_map<CellKey, std::vector<T*>> cells;
+    std::unordered_map<unsigned int, CellKey> lookup;
+
+    int toCell(float v) const { return static_cast<int>(std::floor(v / cellSize)); }
+
+    CellKey keyFor(const Rectangle& bounds) const {
+        return makeGridKey(toCell(bounds.getTopLeft().x), toCell(bounds.getTopLeft().y));
+    }
+
+    void eraseFromCell(CellKey key, T* obj) {
+        auto it = cells.find(key);
+        if (it == cells.end()) return;
+        auto& bucket = it->second;
+        auto pos = std::find(bucket.begin(), bucket.end(), obj);
+        if (pos != bucket.end()) {
+            std::swap(*pos, bucket.back());
+            bucket.pop_back();
+        }
+        if (bucket.empty()) cells.erase(it);
+    }
+
+public:
+    explicit SpatialGrid(float size) : cellSize(size) {}
+
+    void insert(T* obj, const Rectangle& bounds) {
+        CellKey key = keyFor(bounds);
+        lookup[obj->getID()] = key;
+        cells[key].push_back(obj);
+    }
+
+    // Moves the object to a new cell only if its bounds crossed a cell border.
+    void update(T* obj, const Rectangle& bounds) {
+        auto found = lookup.find(obj->getID());
+        if (found == lookup.end()) {
+            insert(obj, bounds);
+            return;
+        }
+        CellKey key = keyFor(bounds);
+        if (key == found->second) return;
+        eraseFromCell(found->second, obj);
+        found->second = key;
+        cells[key].push_back(obj);
+    }
+
+    void remove(T* obj) {
+        auto found = lookup.find(obj->getID());
+        if (found == lookup.end()) return;
+        eraseFromCell(found->second, obj);
+        lookup.erase(found);
+    }
+
+    // Appends every object whose bounds overlap the area. The search starts one
+    // cell up and left of the area to catch objects keyed just outside it.
+    // out is any vector of T*, e.g. a FrameVector for per-tick queries.
+    template<typename Out, typename BoundsFn>
+    void query(const Rectangle& area, Out& out, BoundsFn getBounds) const {
+        int x0 = toCell(area.getTopLeft().x) - 1;
+        int y0 = toCell(area.getTopLeft().y) - 1;
+        int x1 = toCell(area.getBottomRight().x);
+        int y1 = toCell(area.getBottomRight().y);
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                auto it = cells.find(makeGridKey(cx, cy));
+                if (it == cells.end()) continue;
+                for (T* obj : it->second) {
+                    if (area.intersects(getBounds(obj))) out.push_back(obj);
+                }
+            }
+        }
+    }
+
+    void clear() {
+        cells.clear();
+        lookup.clear();
+    }
+
+    size_t size() const { return lookup.size(); }
+};
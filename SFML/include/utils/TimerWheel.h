@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using TimerID = std::uint64_t;
+const TimerID InvalidTimer = 0;
+
+// Hierarchical timing wheel over integer ticks. Four levels of 64 slots
+// cover 64^4 ticks ahead; later timers wait in the top level and are
+// re-filed as it turns. Timers live in a pooled intrusive list, so
+// schedule and cancel are O(1) and advancing only visits the slots passed
+// and the timers that actually come due.
+template<typename T>
+class TimerWheel {
+public:
+    static const int slotBits = 6;
+    static const int slotCount = 1 << slotBits;
+    static const int levelCount = 4;
+
+    TimerWheel() : now(0), live(0) {
+        heads.assign(slotCount * levelCount, -1);
+    }
+
+    // Fires delay ticks from now (at least one).
+    TimerID schedule(std::uint64_t delay, const T& payload) {
+        std::int32_t idx;
+        if (!freeNodes.empty()) {
+            idx = freeNodes.back();
+            freeNodes.pop_back();
+        }
+        else {
+            idx = static_cast<std::int32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        Node& node = nodes[idx];
+        node.payload = payload;
+        node.due = now + (delay > 0 ? delay : 1);
+        node.active = true;
+        insert(idx);
+        live++;
+        return (static_cast<TimerID>(node.generation) << 32) | static_cast<std::uint32_t>(idx + 1);
+    }
+
+    // Returns false if the timer already fired or was cancelled.
+    bool cancel(TimerID id) {
+        std::int32_t idx = static_cast<std::int32_t>(id & 0xffffffffu) - 1;
+        if (idx < 0 || idx >= static_cast<std::int32_t>(nodes.size())) return false;
+        Node& node = nodes[idx];
+        if (!node.active || node.generation != static_cast<std::uint32_t>(id >> 32)) return false;
+        unlink(idx);
+        release(idx);
+        return true;
+    }
+
+    // Moves the wheel to tick target and appends the payload of every timer
+    // due by then, in tick order.
+    void advance(std::uint64_t target, std::vector<T>& expired) {
+        while (now < target) {
+            now++;
+            // Turning over a level re-files its next slot into the levels below.
+            for (int level = 1; level < levelCount; level++) {
+                if ((now & ((std::uint64_t(1) << (slotBits * level)) - 1)) != 0) break;
+                cascade(level, static_cast<int>((now >> (slotBits * level)) & (slotCount - 1)));
+            }
+            std::int32_t& head = heads[now & (slotCount - 1)];
+            while (head >= 0) {
+                std::int32_t idx = head;
+                unlink(idx);
+                if (nodes[idx].due > now) {
+                    // Beyond the wheel's span: re-filed until it is in range.
+                    insert(idx);
+                    continue;
+                }
+                expired.push_back(nodes[idx].payload);
+                release(idx);
+            }
+        }
+    }
+
+    std::uint64_t getTime() const { return now; }
+    size_t size() const { return live; }
+
+private:
+    struct Node {
+        T payload;
+        std::uint64_t due = 0;
+        std::uint32_t generation = 1;
+        std::int32_t prev = -1, next = -1;
+        std::int32_t bucket = -1;
+        bool active = false;
+    };
+
+    void insert(std::int32_t idx) {
+        Node& node = nodes[idx];
+        std::uint64_t delta = node.due > now ? node.due - now : 0;
+        int level = 0;
+        while (level < levelCount - 1 && delta >= (std::uint64_t(1) << (slotBits * (level + 1))))
+            level++;
+        std::uint64_t due = node.due > now ? node.due : now;
+        // Past the top level's span the timer parks in the slot just behind the current one.
+        if (delta >= (std::uint64_t(1) << (slotBits * levelCount)))
+            due = now + (std::uint64_t(1) << (slotBits * levelCount)) - (std::uint64_t(1) << (slotBits * level));
+        std::int32_t bucket = level * slotCount + static_cast<int>((due >> (slotBits * level)) & (slotCount - 1));
+
+        node.bucket = bucket;
+        node.prev = -1;
+        node.next = heads[bucket];
+        if (node.next >= 0) nodes[node.next].prev = idx;
+        heads[bucket] = idx;
+    }
+
+    void unlink(std::int32_t idx) {
+        Node& node = nodes[idx];
+        if (node.prev >= 0) nodes[node.prev].next = node.next;
+        else heads[node.bucket] = node.next;
+        if (node.next >= 0) nodes[node.next].prev = node.prev;
+        node.prev = node.next = node.bucket = -1;
+    }
+
+    void release(std::int32_t idx) {
+        Node& node = nodes[idx];
+        node.active = false;
+        node.payload = T();
+        node.generation++;
+        freeNodes.push_back(idx);
+        live--;
+    }
+
+    void cascade(int level, int slot) {
+        std::int32_t& head = heads[level * slotCount + slot];
+        while (head >= 0) {
+            std::int32_t idx = head;
+            unlink(idx);
+            insert(idx);
+        }
+    }
+
+    std::vector<Node> nodes;
+    std::vector<std::int32_t> freeNodes;
+    std::vector<std::int32_t> heads;
+    std::uint64_t now;
+    size_t live;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <utility>
+
+// Single producer / single consumer triple buffer. The producer always has a
+// free buffer to write into and the consumer always reads the latest
+// published one, so neither side ever waits on the other's frame.
+template<typename T>
+class TripleBuffer {
+    T buffers[3];
+    int writeIdx = 0;
+    int readyIdx = 1;
+    int readIdx = 2;
+    bool fresh = false;
+    std::mutex mtx;
+    std::condition_variable cv;
+
+public:
+    T& writeBuffer() { return buffers[writeIdx]; }
+
+    // Hands the write buffer over to the consumer.
+    void publish() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            std::swap(writeIdx, readyIdx);
+            fresh = true;
+        }
+        cv.notify_one();
+    }
+
+    // Waits for a newly published buffer. Returns nullptr on timeout or wake().
+    const T* acquire(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait_for(lock, timeout, [this] { return fresh; });
+        if (!fresh) return nullptr;
+        std::swap(readIdx, readyIdx);
+        fresh = false;
+        return &buffers[readIdx];
+    }
+
+    void wake() { cv.notify_all(); }
+};
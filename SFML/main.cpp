@@ -1,12 +1,21 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
-#include <fstream>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 #include "include/core/Game.h"
+#include "include/core/LevelGenerator.h"
+#include "include/utils/MemoryTracker.h"
 
 void adaptiveLoop(Game& game, float& lastTime, float updateTarget = 0)
 {
     float current = game.getElapsed().asSeconds();
     float elapsedSeconds = current - lastTime;
+    // Recordings advance by a fixed step, as fast as they can, so runs repeat.
+    bool fixedStep = game.isHeadless() && updateTarget > 0;
+    if (fixedStep)
+        elapsedSeconds = updateTarget;
 
     //Three function calls for the game loop: handleInput, update and render.
     game.handleInput();
@@ -14,7 +23,7 @@ void adaptiveLoop(Game& game, float& lastTime, float updateTarget = 0)
     game.render(elapsedSeconds);
 
     //Sleep to reach constant framerate.
-    if (elapsedSeconds < updateTarget)
+    if (!fixedStep && elapsedSeconds < updateTarget)
     {
         sf::sleep(sf::seconds(updateTarget - elapsedSeconds));
     }
@@ -30,38 +39,127 @@ void adaptiveLoop(Game& game, float& lastTime, float updateTarget = 0)
 
 int main(int argc, char** argv)
 {
-    // Try to load the level:
-    std::ifstream levelRead{ "levels/lvl0.txt" };
-    if (!levelRead)
-    {
-        throw std::exception("File not found\n");
+    Game game;
+
+    // --level <file> picks the level (.txt or binary .lvb);
+    // --convert <in.txt> <out.lvb> writes the binary form of a text level and exits;
+    // --generate <out> writes a procedural level and plays it, shaped by
+    //   --scenario 1k|100k|1m, --size <w>x<h>, --walls <0..1>, --logs <n>,
+    //   --potions <n>, --enemies <n>, --clustered, --seed <n>; --no-run exits after writing;
+    // --record <file.csv> runs headless and writes render and memory stats per frame;
+    // --frames <n> stops after n frames (defaults to 600 when recording);
+    // --budget <subsystem>=<MiB> sets a memory budget (subsystems as in the
+    //   exit report, "total" for all), --hard-budgets makes overruns fatal.
+    std::string levelFile = "levels/lvl0.txt";
+    std::string recordFile;
+    std::string generateFile;
+    LevelGenSettings genSettings;
+    bool run = true;
+    long frameLimit = 0;
+    bool hardBudgets = false;
+    std::vector<std::pair<MemoryTag, size_t>> budgets;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::runtime_error("Missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--level")
+            levelFile = value();
+        else if (arg == "--record")
+            recordFile = value();
+        else if (arg == "--frames")
+            frameLimit = std::stol(value());
+        else if (arg == "--convert") {
+            std::string in = value(), out = value();
+            auto source = LevelSource::open(in, game.chunkTiles);
+            LevelSource::writeBinary(*source, out);
+            std::cout << "Wrote " << out << " (" << source->getWidth() << "x" << source->getHeight() << ")" << std::endl;
+            return 0;
+        }
+        else if (arg == "--generate")
+            generateFile = value();
+        else if (arg == "--scenario") {
+            std::string name = value();
+            if (!LevelGenSettings::fromScenario(name, genSettings))
+                throw std::runtime_error("Unknown scenario: " + name);
+        }
+        else if (arg == "--size") {
+            std::string size = value();
+            size_t x = size.find('x');
+            if (x == std::string::npos) throw std::runtime_error("--size expects <w>x<h>");
+            genSettings.width = std::stoi(size.substr(0, x));
+            genSettings.height = std::stoi(size.substr(x + 1));
+        }
+        else if (arg == "--walls")
+            genSettings.wallDensity = std::stof(value());
+        else if (arg == "--logs")
+            genSettings.logs = std::stoul(value());
+        else if (arg == "--potions")
+            genSettings.potions = std::stoul(value());
+        else if (arg == "--enemies")
+            genSettings.enemies = std::stoul(value());
+        else if (arg == "--clustered")
+            genSettings.distribution = SpawnDistribution::CLUSTERED;
+        else if (arg == "--seed")
+            genSettings.seed = static_cast<std::uint32_t>(std::stoul(value()));
+        else if (arg == "--no-run")
+            run = false;
+        else if (arg == "--budget") {
+            std::string budget = value();
+            size_t eq = budget.find('=');
+            MemoryTag tag;
+            if (eq == std::string::npos || !MemoryTracker::fromName(budget.substr(0, eq), tag))
+                throw std::runtime_error("--budget expects <subsystem>=<MiB>: " + budget);
+            budgets.emplace_back(tag, static_cast<size_t>(std::stod(budget.substr(eq + 1)) * 1024 * 1024));
+        }
+        else if (arg == "--hard-budgets")
+            hardBudgets = true;
     }
 
-    // Convert file to vector of strings:
-    std::vector<std::string> lines;
-    while (levelRead)
-    {
-        std::string strInput;
-        std::getline(levelRead, strInput);
-        lines.emplace_back(strInput);
+    if (!generateFile.empty()) {
+        GeneratedLevel level(genSettings, game.chunkTiles);
+        level.save(generateFile);
+        std::cout << "Wrote " << generateFile << " (" << genSettings.width << "x" << genSettings.height << ", "
+                  << genSettings.logs + genSettings.potions + genSettings.enemies << " entities, seed " << genSettings.seed << ")" << std::endl;
+        levelFile = generateFile;
     }
+    if (!run)
+        return 0;
 
-    // Create and initialize the game.
-    Game game;
-    game.init(lines);
+    for (const auto& budget : budgets)
+        MemoryTracker::setBudget(budget.first, budget.second,
+            hardBudgets ? MemoryTracker::BudgetAction::Fail : MemoryTracker::BudgetAction::Warn);
+
+    if (!recordFile.empty() && frameLimit == 0)
+        frameLimit = 600;
+
+    // Initialize the game.
+    if (!recordFile.empty())
+        game.enableRecording(recordFile);
+    // The level is streamed in chunks around the player rather than read whole.
+    game.init(levelFile);
 
     // GAME LOOP (targeting 60FPS)
     float updateTarget = 0.016f; // 60 FPS = ~0.016 sec per frame
     float lastTime = game.getElapsed().asSeconds();
 
-    while (!game.getWindow()->isWindowDone())
+    long frame = 0;
+    Window* window = game.getWindow();
+    while ((!window || !window->isWindowDone()) && (frameLimit == 0 || frame < frameLimit))
     {
         adaptiveLoop(game, lastTime, updateTarget);
+        frame++;
     }
 
+    std::cout << "Memory by subsystem:\n";
+    MemoryTracker::report(std::cout);
+
     // Pause before exiting so you can see console output.
-    std::cout << "Press Enter to exit...";
-    std::cin.get();
+    if (!game.isHeadless()) {
+        std::cout << "Press Enter to exit...";
+        std::cin.get();
+    }
 
     return 0;
 }
@@ -20,9 +20,6 @@ void PlayerInputComponent::update(Game& game)
         velComp->setVelocity(0.f, 0.f);
     }
 
-    // Retrieve commands from the PlayerInputHandler and execute them.
-    auto& commands = inputHandler->handleInput();
-    for (auto& cmd : commands) {
-        cmd->execute(game);
-    }
+    // Execute the commands for this tick's actions.
+    inputHandler->handleInput(game.getActions(), game);
 }
@@ -0,0 +1,42 @@
+#include "../../include/core/AssetLoader.h"
+#include <stdexcept>
+
+AssetLoader::AssetLoader(unsigned int threads) : pool(threads) {}
+
+AssetLoader::ImageHandle AssetLoader::requestImage(const std::string& file) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = images.find(file);
+    if (it != images.end())
+        return it->second;
+
+    ImageHandle handle = pool.submit([file]() -> std::shared_ptr<const sf::Image> {
+        auto image = std::make_shared<sf::Image>();
+        if (!image->loadFromFile(file))
+            throw std::runtime_error("Image load failed: " + file);
+        return image;
+    }).share();
+    images[file] = handle;
+    return handle;
+}
+
+void AssetLoader::release(const std::string& file) {
+    std::lock_guard<std::mutex> lock(mtx);
+    images.erase(file);
+    sounds.erase(file);
+}
+
+AssetLoader::SoundHandle AssetLoader::requestSound(const std::string& file) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = sounds.find(file);
+    if (it != sounds.end())
+        return it->second;
+
+    SoundHandle handle = pool.submit([file]() -> std::shared_ptr<const sf::SoundBuffer> {
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        if (!buffer->loadFromFile(file))
+            throw std::runtime_error("Sound load failed: " + file);
+        return buffer;
+    }).share();
+    sounds[file] = handle;
+    return handle;
+}
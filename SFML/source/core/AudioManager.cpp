@@ -1,18 +1,74 @@
 #include "../../include/core/AudioManager.h"
-#include <iostream>
 
-void AudioManager::loadSound(const std::string& name, const std::string& filepath) {
-    sf::SoundBuffer buffer;
-    if (!buffer.loadFromFile(filepath)) {
-        std::cerr << "[AudioManager] Failed to load: " << filepath << "\n";
+AudioManager::AudioManager(std::unique_ptr<AudioSink> audioSink)
+    : sink(std::move(audioSink)), commands(queueCapacity), dropped(0), running(false), sleeping(false)
+{
+    if (!sink) sink = std::make_unique<NullAudioSink>();
+}
+
+AudioManager::~AudioManager() {
+    stop();
+}
+
+SoundID AudioManager::loadSound(const std::string& name, const std::string& filepath, const SoundSettings& settings) {
+    return sink->loadSound(name, filepath, settings);
+}
+
+void AudioManager::finishLoading() {
+    sink->finishLoading();
+}
+
+void AudioManager::start() {
+    if (running) return;
+    running = true;
+    thread = std::thread(&AudioManager::run, this);
+}
+
+void AudioManager::stop() {
+    if (!running) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wake.notify_one();
+    if (thread.joinable())
+        thread.join();
+    sink->stopAll();
+}
+
+void AudioManager::push(const AudioCommand& cmd) {
+    if (!commands.push(cmd)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
         return;
     }
-    buffers[name] = buffer;
-    sounds[name].setBuffer(buffers[name]);
+    // Pairs with the fence in run(): either the audio thread sees this
+    // command before sleeping, or this sees it asleep and wakes it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+}
+
+void AudioManager::drain() {
+    AudioCommand cmd;
+    while (commands.pop(cmd)) {
+        switch (cmd.type) {
+        case AudioCommand::Play: sink->play(cmd.id); break;
+        case AudioCommand::Stop: sink->stop(cmd.id); break;
+        case AudioCommand::StopAll: sink->stopAll(); break;
+        }
+    }
 }
 
-void AudioManager::playSound(const std::string& name) {
-    if (sounds.count(name)) {
-        sounds[name].play();
+void AudioManager::run() {
+    while (running) {
+        drain();
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake.wait(lock, [this] { return !running || !commands.empty(); });
+        sleeping.store(false, std::memory_order_relaxed);
     }
+    drain();
 }
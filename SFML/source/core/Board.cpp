@@ -1,27 +1,33 @@
 #include "../../include/core/Board.h"
+#include "../../include/utils/Rectangle.h"
+#include "../../include/utils/MemoryTracker.h"
 #include <stdexcept>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
-Board::Board(size_t w, size_t h) : width(w), height(h) {
-    grid.resize(width * height, nullptr);
+Board::Board(size_t w, size_t h, int chunk) : width(w), height(h), chunkTiles(chunk), tileSize(0.f), revision(0) {
+    if (chunkTiles <= 0) throw std::runtime_error("Board: chunk size must be positive");
 }
 
 Board::~Board() {
-    for (auto* tile : grid) delete tile;
+    for (size_t i = 0; i < chunks.size(); i++)
+        MemoryTracker::remove(MemoryTag::Board, chunkBytes());
 }
 
 bool Board::inBounds(int x, int y) const {
     return x >= 0 && x < static_cast<int>(width) && y >= 0 && y < static_cast<int>(height);
 }
 
-void Board::addTile(int x, int y, float scale, TileType type, const std::string& textureFile) {
-    if (!inBounds(x, y)) throw std::runtime_error("addTile: out of bounds");
-
-    int idx = y * static_cast<int>(width) + x;
-    if (grid[idx]) {
-        delete grid[idx];
-        grid[idx] = nullptr;
+std::uint8_t Board::paletteCode(TileType type, float scale, const std::string& textureFile) {
+    auto found = paletteCodes.find({ type, textureFile });
+    if (found != paletteCodes.end()) {
+        // The flyweight carries the scale; a second one would change the grid.
+        if (palette[found->second - 1].getScale() != scale)
+            throw std::runtime_error("Board: tile " + textureFile + " added with a different scale");
+        return found->second;
     }
+    if (palette.size() >= 255) throw std::runtime_error("Board: too many tile kinds");
 
     // Reuse or load texture
     auto it = textureMap.find(textureFile);
@@ -38,16 +44,80 @@ void Board::addTile(int x, int y, float scale, TileType type, const std::string&
         textureMap[textureFile] = tex;
     }
 
-    Tile* newTile = new Tile(type);
-    newTile->loadTile(x, y, scale, tex);
-    grid[idx] = newTile;
+    palette.emplace_back(type, tex, scale);
+    tileSize = palette.back().getSize();
+    std::uint8_t code = static_cast<std::uint8_t>(palette.size());
+    paletteCodes[{ type, textureFile }] = code;
+    return code;
+}
+
+void Board::addTile(int x, int y, float scale, TileType type, const std::string& textureFile) {
+    if (!inBounds(x, y)) throw std::runtime_error("addTile: out of bounds");
+
+    std::uint8_t code = paletteCode(type, scale, textureFile);
+    GridKey key = makeGridKey(x / chunkTiles, y / chunkTiles);
+    Chunk& chunk = chunks[key];
+    if (chunk.empty()) {
+        chunk.assign(static_cast<size_t>(chunkTiles) * chunkTiles, emptyCell);
+        MemoryTracker::add(MemoryTag::Board, chunkBytes());
+    }
+    std::uint8_t& cell = chunk[(y % chunkTiles) * chunkTiles + (x % chunkTiles)];
+    if (cell != code) {
+        // Pathfinding only cares about the type; a texture change is not a new revision.
+        bool retyped = cell == emptyCell || palette[cell - 1].getType() != type;
+        cell = code;
+        if (retyped) chunkStamps[key] = ++revision;
+    }
+}
+
+void Board::unloadChunk(int cx, int cy) {
+    GridKey key = makeGridKey(cx, cy);
+    if (chunks.erase(key)) {
+        MemoryTracker::remove(MemoryTag::Board, chunkBytes());
+        revision++;
+    }
+    chunkStamps.erase(key);
+}
+
+std::uint64_t Board::getChunkStamp(int cx, int cy) const {
+    auto it = chunkStamps.find(makeGridKey(cx, cy));
+    return it == chunkStamps.end() ? 0 : it->second;
 }
 
-void Board::draw(Window* wnd) {
-    for (int y = 0; y < static_cast<int>(height); y++) {
-        for (int x = 0; x < static_cast<int>(width); x++) {
-            Tile* tile = grid[y * static_cast<int>(width) + x];
-            if (tile) tile->draw(wnd);
+const Tile* Board::getTile(int x, int y) const {
+    if (!inBounds(x, y)) return nullptr;
+    auto it = chunks.find(makeGridKey(x / chunkTiles, y / chunkTiles));
+    if (it == chunks.end()) return nullptr;
+    std::uint8_t code = it->second[(y % chunkTiles) * chunkTiles + (x % chunkTiles)];
+    return code == emptyCell ? nullptr : &palette[code - 1];
+}
+
+void Board::draw(RenderCommandList& commands, const Rectangle& area) const {
+    if (tileSize <= 0.f) return;
+
+    // Tile coordinates are the spatial index: clip the loops to the visible range.
+    int x0 = std::max(0, static_cast<int>(std::floor(area.getTopLeft().x / tileSize)));
+    int y0 = std::max(0, static_cast<int>(std::floor(area.getTopLeft().y / tileSize)));
+    int x1 = std::min(static_cast<int>(width) - 1, static_cast<int>(std::floor(area.getBottomRight().x / tileSize)));
+    int y1 = std::min(static_cast<int>(height) - 1, static_cast<int>(std::floor(area.getBottomRight().y / tileSize)));
+    if (x0 > x1 || y0 > y1) return;
+
+    // One lookup per chunk, then a clipped walk over its cells.
+    for (int cy = y0 / chunkTiles; cy <= y1 / chunkTiles; cy++) {
+        for (int cx = x0 / chunkTiles; cx <= x1 / chunkTiles; cx++) {
+            auto it = chunks.find(makeGridKey(cx, cy));
+            if (it == chunks.end()) continue;
+            const Chunk& chunk = it->second;
+
+            int baseX = cx * chunkTiles, baseY = cy * chunkTiles;
+            int ty0 = std::max(y0, baseY) - baseY, ty1 = std::min(y1, baseY + chunkTiles - 1) - baseY;
+            int tx0 = std::max(x0, baseX) - baseX, tx1 = std::min(x1, baseX + chunkTiles - 1) - baseX;
+            for (int ty = ty0; ty <= ty1; ty++) {
+                for (int tx = tx0; tx <= tx1; tx++) {
+                    std::uint8_t code = chunk[ty * chunkTiles + tx];
+                    if (code != emptyCell) palette[code - 1].draw(commands, baseX + tx, baseY + ty);
+                }
+            }
         }
     }
 }
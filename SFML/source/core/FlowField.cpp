@@ -0,0 +1,145 @@
+#include "../../include/core/FlowField.h"
+#include "../../include/core/Board.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    // Orthogonal neighbours first; the search itself only uses those four.
+    const int offsets[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+                                { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } };
+}
+
+FlowField::FlowField() : hasRequest(false), hasResult(false), running(false) {}
+
+FlowField::~FlowField() {
+    stop();
+}
+
+void FlowField::start() {
+    if (running) return;
+    running = true;
+    worker = std::thread(&FlowField::run, this);
+}
+
+void FlowField::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        running = false;
+    }
+    wakeUp.notify_one();
+    if (worker.joinable())
+        worker.join();
+}
+
+void FlowField::request(const Board& board, const sf::Vector2i& goal, int radius) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Field& field = pending;
+        field.goal = goal;
+        field.origin = sf::Vector2i(goal.x - radius, goal.y - radius);
+        field.width = field.height = 2 * radius + 1;
+        field.walkable.resize(static_cast<size_t>(field.width) * field.height);
+        for (int y = 0; y < field.height; y++) {
+            for (int x = 0; x < field.width; x++) {
+                // Unloaded cells are treated as walls until they stream in.
+                const Tile* tile = board.getTile(field.origin.x + x, field.origin.y + y);
+                field.walkable[static_cast<size_t>(y) * field.width + x] = tile && tile->getType() == TileType::CORRIDOR;
+            }
+        }
+        hasRequest = true;
+    }
+    wakeUp.notify_one();
+}
+
+bool FlowField::poll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasResult) return false;
+    std::swap(current, finished);
+    hasResult = false;
+    return true;
+}
+
+void FlowField::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return !running || hasRequest; });
+            if (!running) return;
+            std::swap(pending, working);
+            hasRequest = false;
+        }
+        compute(working);
+        std::lock_guard<std::mutex> lock(mutex);
+        std::swap(working, finished);
+        hasResult = true;
+    }
+}
+
+void FlowField::compute(Field& field) {
+    size_t cells = static_cast<size_t>(field.width) * field.height;
+    field.distance.assign(cells, -1);
+    field.step.assign(cells, -1);
+    field.frontier.clear();
+    field.frontier.reserve(cells);
+    field.ready = true;
+
+    auto walkable = [&field](int x, int y) {
+        return x >= 0 && y >= 0 && x < field.width && y < field.height
+            && field.walkable[static_cast<size_t>(y) * field.width + x];
+    };
+
+    int gx = field.goal.x - field.origin.x, gy = field.goal.y - field.origin.y;
+    if (!walkable(gx, gy)) return;
+
+    // Unit costs, so a breadth-first flood is Dijkstra; the frontier vector doubles as the queue.
+    field.distance[static_cast<size_t>(gy) * field.width + gx] = 0;
+    field.frontier.push_back(gy * field.width + gx);
+    for (size_t head = 0; head < field.frontier.size(); head++) {
+        int idx = field.frontier[head];
+        int x = idx % field.width, y = idx / field.width;
+        for (int n = 0; n < 4; n++) {
+            int nx = x + offsets[n][0], ny = y + offsets[n][1];
+            if (!walkable(nx, ny)) continue;
+            int nidx = ny * field.width + nx;
+            if (field.distance[nidx] >= 0) continue;
+            field.distance[nidx] = field.distance[idx] + 1;
+            field.frontier.push_back(nidx);
+        }
+    }
+
+    // Each reached cell points at its lowest neighbour. Diagonals are taken
+    // only when both orthogonal cells are open so agents never clip a corner.
+    for (int idx : field.frontier) {
+        int x = idx % field.width, y = idx / field.width;
+        int best = field.distance[idx];
+        for (int n = 0; n < 8; n++) {
+            int nx = x + offsets[n][0], ny = y + offsets[n][1];
+            if (!walkable(nx, ny)) continue;
+            if (n >= 4 && (!walkable(nx, y) || !walkable(x, ny))) continue;
+            int d = field.distance[ny * field.width + nx];
+            if (d >= 0 && d < best) {
+                best = d;
+                field.step[idx] = static_cast<std::int8_t>(n);
+            }
+        }
+    }
+}
+
+int FlowField::indexOf(int x, int y) const {
+    int lx = x - current.origin.x, ly = y - current.origin.y;
+    if (!current.ready || lx < 0 || ly < 0 || lx >= current.width || ly >= current.height) return -1;
+    return ly * current.width + lx;
+}
+
+sf::Vector2i FlowField::getStep(int x, int y) const {
+    int idx = indexOf(x, y);
+    if (idx < 0 || current.step[idx] < 0) return sf::Vector2i(0, 0);
+    const int* offset = offsets[current.step[idx]];
+    return sf::Vector2i(offset[0], offset[1]);
+}
+
+int FlowField::getDistance(int x, int y) const {
+    int idx = indexOf(x, y);
+    return idx < 0 ? -1 : current.distance[idx];
+}
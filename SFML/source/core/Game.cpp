@@ -1,24 +1,38 @@
 ﻿#include "../../include/core/Game.h"
 #include "../../include/entities/Fire.h"
 #include "../../include/entities/StaticEntities.h"
+#include "../../include/entities/Enemy.h"
 #include <iostream>
 #include "../../include/core/Command.h"
 #include "../../include/core/InputHandler.h"
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <sstream>
 #include "../../include/systems/Systems.h"
-#include "../../include/utils/Observer.h"
 #include "../../include/core/AudioManager.h"
+#include "../../include/core/VoicePoolSink.h"
 #include "../../include/core/ServiceLocator.h"
+#include "../../include/utils/FrameArena.h"
 
 void Game::registerCollisionCallback(EntityType type, std::function<void(Entity*)> callback) {
     collisionCallbacks[type] = callback;
 }
 
 std::shared_ptr<AudioManager> ServiceLocator::audioService = nullptr;
+std::shared_ptr<AssetLoader> ServiceLocator::assetService = nullptr;
+std::shared_ptr<TextureCache> ServiceLocator::textureService = nullptr;
+std::shared_ptr<SpriteSheetCache> ServiceLocator::spriteSheetService = nullptr;
+std::shared_ptr<AnimationSystem> ServiceLocator::animationService = nullptr;
+std::shared_ptr<ParticleSystem> ServiceLocator::particleService = nullptr;
+std::shared_ptr<EventBus> ServiceLocator::eventService = nullptr;
+std::shared_ptr<RenderStore> ServiceLocator::renderService = nullptr;
 
 Game::Game(ECSType type)
-    : paused(false), entityCounter(1), ecsType(type)
+    : paused(false), fps(0),
+    flowRevision(0), flowRequested(false), simTime(0.0),
+    entityGrid(spriteWH * tileScale * gridCellTiles),
+    entityCounter(1), ecsType(type), frameIndex(0)
 {
     inputHandler = std::make_unique<InputHandler>();
 
@@ -44,12 +58,6 @@ Game::Game(ECSType type)
         archetypes.push_back(movableEntities);
         archetypes.push_back(drawableEntities);
     }
-
-
-    //Initialized TTLSystem and add it to systems vector
-    auto ttlSystem = std::make_shared<TTLSystem>();
-    systems.push_back(ttlSystem);
-
 }
 
 // Big array function
@@ -65,90 +73,286 @@ void Game::bigArray(float elapsed) {
 
 
 
-Game::~Game() {}
-
-void Game::init(std::vector<std::string> lines)
+Game::~Game()
 {
-    size_t h = lines.size();
-    if (h == 0) throw std::exception("No data in level file");
-    size_t w = static_cast<size_t>(-1);
+    renderThread.stop();
+    if (levelStreamer) levelStreamer->stop();
+    flowField.stop();
+}
 
-    window.loadFont("font/AmaticSC-Regular.ttf");
-    window.setTitle("Mini-Game");
+void Game::init(const std::string& levelFile)
+{
+    // Start decoding every startup image and sound on the asset loader's pool.
+    // Textures are uploaded on this thread when first used, or in finishLoading;
+    // headless runs only decode them, so no GL context is needed.
+    auto assets = std::make_shared<AssetLoader>();
+    ServiceLocator::provide(assets);
+    auto textures = std::make_shared<TextureCache>(assets, !isHeadless());
+    for (const char* file : { "img/floor.png", "img/wall.png", "img/log.png", "img/potion.png",
+                              Fire::textureFile, "img/mushroom50-50.png", "img/DwarfSpriteSheet.png" })
+        textures->prefetch(file);
+    ServiceLocator::provide(textures);
 
     // INIT AUDIO MANAGER and REGISTER SERVICE LOCATOR
-    auto audio = std::make_shared<AudioManager>();
-    audio->loadSound("pickup", "audio/potion_collect.wav");
-    audio->loadSound("fire", "audio/fire.wav");
-    audio->loadSound("axe", "audio/sword-slash.wav");
+    // Headless runs have no audio device to talk to.
+    std::unique_ptr<AudioSink> sink;
+    if (isHeadless())
+        sink = std::make_unique<NullAudioSink>();
+    else
+        sink = std::make_unique<VoicePoolSink>(assets);
+    auto audio = std::make_shared<AudioManager>(std::move(sink));
+    SoundSettings pickupSound;
+    pickupSound.cooldown = 0.03f;
+    SoundSettings fireSound;
+    fireSound.priority = 2;
+    // The axe is triggered every frame of the attack's action window; one swing is one sound.
+    SoundSettings axeSound;
+    axeSound.priority = 1;
+    axeSound.cooldown = 0.3f;
+    audio->loadSound("pickup", "audio/potion_collect.wav", pickupSound);
+    audio->loadSound("fire", "audio/fire.wav", fireSound);
+    audio->loadSound("axe", "audio/sword-slash.wav", axeSound);
     ServiceLocator::provide(audio);
 
-    auto it = lines.cbegin();
-    int row = 0;
-    while (it != lines.cend())
-    {
-        int col = 0;
-        if (w == static_cast<size_t>(-1))
-        {
-            w = it->size();
-            buildBoard(w, h);
-            initWindow(w, h);
+    // The font loads here while the pool decodes.
+    if (!isHeadless()) {
+        window = std::make_unique<Window>();
+        window->loadFont("font/AmaticSC-Regular.ttf");
+        window->setTitle("Mini-Game");
+    }
+    ServiceLocator::provide(std::make_shared<SpriteSheetCache>());
+    ServiceLocator::provide(std::make_shared<RenderStore>());
+    animationSystem = std::make_shared<AnimationSystem>();
+    ServiceLocator::provide(animationSystem);
+    particleSystem = std::make_shared<ParticleSystem>();
+    ServiceLocator::provide(particleSystem);
+
+    events = std::make_shared<EventBus>();
+    ServiceLocator::provide(events);
+    achievements.subscribe(*events);
+    // One sound per batch: the voice cooldown would swallow the rest anyway.
+    events->subscribe<PotionCollected>([audio](const std::vector<PotionCollected>&) {
+        audio->playSound(SoundIDs::pickup);
+    });
+    events->subscribe<ShoutPerformed>([audio](const std::vector<ShoutPerformed>&) {
+        audio->playSound(SoundIDs::fire);
+    });
+
+    this->levelFile = levelFile;
+    levelStreamer = std::make_unique<LevelStreamer>(chunkTiles);
+    levelStreamer->open(levelFile);
+    if (!levelStreamer->hasSpawn()) throw std::runtime_error("No player spawn in level file: " + levelFile);
+
+    buildBoard(levelStreamer->getWidth(), levelStreamer->getHeight());
+    initWindow(levelStreamer->getWidth(), levelStreamer->getHeight());
+
+    // Read the chunks around the spawn up front so the first frame has ground under the player.
+    const sf::Vector2i& spawn = levelStreamer->getSpawn();
+    int spawnCX = spawn.x / levelStreamer->getChunkTiles(), spawnCY = spawn.y / levelStreamer->getChunkTiles();
+    for (int cy = std::max(0, spawnCY - streamRadius); cy <= std::min(levelStreamer->getChunksY() - 1, spawnCY + streamRadius); cy++) {
+        for (int cx = std::max(0, spawnCX - streamRadius); cx <= std::min(levelStreamer->getChunksX() - 1, spawnCX + streamRadius); cx++) {
+            integrateChunk(levelStreamer->loadNow(cx, cy));
         }
-        std::string::const_iterator is = it->cbegin();
-        while (is != it->cend())
+    }
+
+    firePool.reserve(firePoolSize);
+
+    player = makeTracked<Player>(MemoryTag::Entities);
+    player->initSpriteSheet("img/DwarfSpriteSheet_data.txt");
+    player->positionSprite(spawn.y, spawn.x, spriteWH, tileScale);
+    addEntity(player);
+
+    // Register collision callbacks
+    registerCollisionCallback(EntityType::POTION, std::bind(&Player::handlePotionCollision, player.get(), std::placeholders::_1));
+    registerCollisionCallback(EntityType::LOG, std::bind(&Player::handleLogCollision, player.get(), std::placeholders::_1));
+
+    textures->finishLoading();
+    audio->finishLoading();
+    audio->start();
+    levelStreamer->start();
+    flowField.start();
+    watchAssets();
+
+    // Hand the window over to the render thread. Recordings are written from render().
+    if (!recorder) {
+        renderThread.setBackend(window.get());
+        renderThread.start();
+    }
+}
+
+void Game::integrateChunk(const LevelChunk& chunk)
+{
+    StreamedChunk& record = chunks[makeGridKey(chunk.cx, chunk.cy)];
+    record.cx = chunk.cx;
+    record.cy = chunk.cy;
+    record.loaded = true;
+    addChunkTiles(chunk);
+
+    for (const LevelSpawn& spawn : chunk.spawns) {
+        GridKey cell = makeGridKey(spawn.x, spawn.y);
+        if (consumedSpawns.count(cell)) continue;
+        std::shared_ptr<Entity> ent;
+        switch (spawn.type)
         {
-            switch (*is)
+            case SpawnType::LOG:
+                ent = buildEntityAt<Log>("img/log.png", spawn.x, spawn.y);
+                break;
+            case SpawnType::POTION:
+                ent = buildEntityAt<Potion>("img/potion.png", spawn.x, spawn.y);
+                break;
+            case SpawnType::ENEMY:
+                ent = buildEntityAt<Enemy>("img/mushroom50-50.png", spawn.x, spawn.y);
+                break;
+        }
+        if (!ent) continue;
+        addEntity(ent);
+        record.spawns.emplace_back(cell, ent);
+    }
+}
+
+void Game::addChunkTiles(const LevelChunk& chunk)
+{
+    for (int y = 0; y < chunk.height; y++) {
+        for (int x = 0; x < chunk.width; x++) {
+            int col = chunk.originX + x;
+            int row = chunk.originY + y;
+            switch (chunk.at(x, y))
             {
-                case '.':
+                case LevelTile::CORRIDOR:
                     board->addTile(col, row, tileScale, TileType::CORRIDOR, "img/floor.png");
                     break;
-                case 'w':
+                case LevelTile::WALL:
                     board->addTile(col, row, tileScale, TileType::WALL, "img/wall.png");
                     break;
-                case 'x':
-                {
-                    auto ent = buildEntityAt<Log>("img/log.png", col, row);
-                    addEntity(ent);
-                    board->addTile(col, row, tileScale, TileType::CORRIDOR, "img/floor.png");
-                    break;
-                }
-                case 'p':
-                {
-                    auto ent = buildEntityAt<Potion>("img/potion.png", col, row);
-                    addEntity(ent);
-                    board->addTile(col, row, tileScale, TileType::CORRIDOR, "img/floor.png");
+                case LevelTile::NONE:
                     break;
-                }
-                case '*':
-                {
-                    player = std::make_shared<Player>();
-                    player->initSpriteSheet("img/DwarfSpriteSheet_data.txt");
-                    player->positionSprite(row, col, spriteWH, tileScale);
-                    addEntity(player);
-                    board->addTile(col, row, tileScale, TileType::CORRIDOR, "img/floor.png");
-
-                    // Observer Pattern: Create and assign
-                    achievementObserver = std::make_shared<AchievementObserver>();
-                    player->setObserver(achievementObserver);
-					// Register collision callbacks
-                    registerCollisionCallback(EntityType::POTION, std::bind(&Player::handlePotionCollision, player.get(), std::placeholders::_1));
-                    registerCollisionCallback(EntityType::LOG, std::bind(&Player::handleLogCollision, player.get(), std::placeholders::_1));
-                    break;
-                }
             }
-            col++;
-            is++;
         }
-        row++;
-        it++;
     }
 }
 
+void Game::releaseChunk(StreamedChunk& chunk)
+{
+    board->unloadChunk(chunk.cx, chunk.cy);
+    for (auto& spawn : chunk.spawns) {
+        auto ent = spawn.second.lock();
+        if (!ent || ent->isDeleted())
+            consumedSpawns.insert(spawn.first);
+        else
+            ent->deleteEntity();
+    }
+    chunk.spawns.clear();
+}
+
+void Game::updateStreaming()
+{
+    // Integrate what the worker finished; chunks that left the range meanwhile are dropped.
+    arrivedChunks.clear();
+    levelStreamer->poll(arrivedChunks);
+    for (const auto& chunk : arrivedChunks) {
+        auto it = chunks.find(makeGridKey(chunk.cx, chunk.cy));
+        if (it == chunks.end() || it->second.loaded) continue;
+        if (!chunk.error.empty()) {
+            // The record stays unloaded, so the chunk is not asked for again
+            // until it leaves the range or the level reloads.
+            std::cerr << "[LevelStreamer] Chunk " << chunk.cx << "," << chunk.cy << ": " << chunk.error << std::endl;
+            continue;
+        }
+        integrateChunk(chunk);
+    }
+
+    const Rectangle& bb = player->getBoundingBox();
+    float chunkSize = spriteWH * tileScale * levelStreamer->getChunkTiles();
+    int playerCX = static_cast<int>(bb.getTopLeft().x / chunkSize);
+    int playerCY = static_cast<int>(bb.getTopLeft().y / chunkSize);
+
+    for (int cy = std::max(0, playerCY - streamRadius); cy <= std::min(levelStreamer->getChunksY() - 1, playerCY + streamRadius); cy++) {
+        for (int cx = std::max(0, playerCX - streamRadius); cx <= std::min(levelStreamer->getChunksX() - 1, playerCX + streamRadius); cx++) {
+            auto inserted = chunks.try_emplace(makeGridKey(cx, cy));
+            if (!inserted.second) continue;
+            inserted.first->second.cx = cx;
+            inserted.first->second.cy = cy;
+            levelStreamer->request(cx, cy);
+        }
+    }
+
+    int keep = streamRadius + 1;
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        StreamedChunk& chunk = it->second;
+        if (std::abs(chunk.cx - playerCX) > keep || std::abs(chunk.cy - playerCY) > keep) {
+            releaseChunk(chunk);
+            it = chunks.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void Game::updateFlowField()
+{
+    flowField.poll();
+
+    const Rectangle& bb = player->getBoundingBox();
+    float tileSize = spriteWH * tileScale;
+    sf::Vector2i goal(static_cast<int>((bb.getTopLeft().x + bb.getBottomRight().x) * 0.5f / tileSize),
+                      static_cast<int>((bb.getTopLeft().y + bb.getBottomRight().y) * 0.5f / tileSize));
+    if (flowRequested && goal == flowGoal && board->getRevision() == flowRevision) return;
+
+    // Only a goal or tile change invalidates the field; a frame without either costs nothing.
+    flowGoal = goal;
+    flowRevision = board->getRevision();
+    flowRequested = true;
+    flowField.request(*board, goal, levelStreamer->getChunkTiles() * (streamRadius + 1));
+}
+
+TimerID Game::scheduleTimer(float seconds, std::shared_ptr<Entity> entity, EntityTimer event)
+{
+    auto ticks = static_cast<std::uint64_t>(std::ceil(seconds / timerTick));
+    return timers.schedule(ticks, { entity, event });
+}
+
+void Game::cancelTimer(TimerID id)
+{
+    timers.cancel(id);
+}
+
+void Game::updateTimers(float elapsed)
+{
+    // Simulation time, so timers stop while paused and do not depend on frame rate.
+    simTime += elapsed;
+    expiredTimers.clear();
+    timers.advance(static_cast<std::uint64_t>(simTime / timerTick), expiredTimers);
+
+    // Only the entities whose timers came due this tick are touched.
+    for (const auto& timer : expiredTimers) {
+        auto ent = timer.entity.lock();
+        if (!ent || ent->isDeleted()) continue;
+        if (timer.event == EntityTimer::EXPIRE)
+            ent->deleteEntity();
+        else
+            ent->onTimer(timer.event);
+    }
+}
+
+std::shared_ptr<Fire> Game::spawnFire(const sf::Vector2f& position, const sf::Vector2f& velocity)
+{
+    auto fire = firePool.acquire(position, velocity);
+    addEntity(fire);
+    return fire;
+}
+
 void Game::addEntity(std::shared_ptr<Entity> newEntity)
 {
-    entityCounter++;
-    newEntity->setID(entityCounter);
+    // Pooled entities coming back keep the ID they were given the first time.
+    if (newEntity->getID() == 0) {
+        entityCounter++;
+        newEntity->setID(entityCounter);
+    }
     entities.push_back(newEntity);
+    entityGrid.insert(newEntity.get(), newEntity->getBoundingBox());
+    if (auto ttl = newEntity->getTTLComponent())
+        ttl->setTimer(scheduleTimer(ttl->getLifetime(), newEntity, EntityTimer::EXPIRE));
 
     // Add entity to corresponding archetypes if using Archetypes ECS
     if (ecsType == ECSType::ARCHETYPES) {
@@ -163,22 +367,128 @@ void Game::addEntity(std::shared_ptr<Entity> newEntity)
     }
 }
 
+void Game::enableRecording(const std::string& file)
+{
+    recorder = std::make_unique<RecordingRenderBackend>(file);
+}
+
 void Game::handleInput()
 {
-    auto cmd = inputHandler->handleInput();
-    if (cmd) { cmd->execute(*this); }
+    // Recorded runs are driven without input so they stay reproducible.
+    if (isHeadless()) return;
+    // Key events queued by the last window update become this tick's actions.
+    inputHandler->update(window->getInput());
+    inputHandler->dispatch(*this);
     if (player) { player->handleInput(*this); }
 }
 
+const ActionState& Game::getActions() const
+{
+    return inputHandler->getActions();
+}
+
+void Game::watchAssets()
+{
+    fileWatcher.watch(levelFile);
+    for (const auto& file : ServiceLocator::getTextures()->getFiles())
+        fileWatcher.watch(file);
+    for (const auto& file : ServiceLocator::getSpriteSheets()->getFiles())
+        fileWatcher.watch(file);
+}
+
+void Game::checkHotReload()
+{
+    changedFiles.clear();
+    fileWatcher.poll(changedFiles);
+    if (changedFiles.empty()) return;
+
+    auto textures = ServiceLocator::getTextures();
+    auto sheets = ServiceLocator::getSpriteSheets();
+
+    // Textures are swapped in place, which must not race the render thread.
+    renderThread.stop();
+    for (const auto& file : changedFiles) {
+        // A failed reload (e.g. a half-saved file) keeps the old asset.
+        try {
+            if (file == levelFile)
+                reloadLevel();
+            else if (sheets->contains(file))
+                reloadSpriteSheet(file);
+            else if (textures->contains(file))
+                textures->reload(file);
+            std::cout << "[HotReload] " << file << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "[HotReload] " << file << ": " << e.what() << std::endl;
+        }
+    }
+    renderThread.start();
+
+    // Reloaded sprite sheets may refer to textures that were not watched yet.
+    watchAssets();
+}
+
+void Game::reloadSpriteSheet(const std::string& file)
+{
+    auto sheets = ServiceLocator::getSpriteSheets();
+    auto previous = sheets->get(file);
+    auto fresh = sheets->reload(file);
+    for (auto& ent : entities)
+        ent->reloadSpriteSheet(previous.get(), fresh);
+}
+
+void Game::reloadLevel()
+{
+    // Open the new version first so a broken file leaves the running level untouched.
+    auto reopened = std::make_unique<LevelStreamer>(chunkTiles);
+    reopened->open(levelFile);
+    bool sameChunks = reopened->getChunkTiles() == levelStreamer->getChunkTiles();
+    levelStreamer->stop();
+    levelStreamer = std::move(reopened);
+
+    buildBoard(levelStreamer->getWidth(), levelStreamer->getHeight());
+    camera.setWorldSize(sf::Vector2f(levelStreamer->getWidth() * spriteWH * tileScale,
+                                     levelStreamer->getHeight() * spriteWH * tileScale));
+
+    if (!sameChunks) {
+        // Chunk coordinates changed meaning: drop everything and stream in afresh.
+        for (auto& entry : chunks)
+            releaseChunk(entry.second);
+        chunks.clear();
+    }
+    else {
+        // Entities keep their state; only tiles are rebuilt. Chunks still in
+        // flight were lost with the old worker and, like failed ones, are asked for again.
+        for (auto& entry : chunks) {
+            StreamedChunk& chunk = entry.second;
+            if (chunk.loaded)
+                addChunkTiles(levelStreamer->loadNow(chunk.cx, chunk.cy));
+            else
+                levelStreamer->request(chunk.cx, chunk.cy);
+        }
+    }
+    levelStreamer->start();
+}
+
 void Game::update(float elapsed)
 {
+    // Transient data of the previous tick (and the frame drawn after it) is dropped here.
+    FrameArena::local().reset();
+    // Warns about, or throws on, subsystems over their memory budget.
+    MemoryTracker::checkBudgets(std::cerr);
+
+    if (!isHeadless())
+        checkHotReload();
 
     if (!paused) {
+        updateTimers(elapsed);
         bigArray(elapsed);
 
         for (auto& ent : entities) {
             ent->update(this, elapsed);
         }
+        animationSystem->update(elapsed);
+        particleSystem->update(elapsed);
     }
 
     if (ecsType == ECSType::ARCHETYPES)
@@ -189,17 +499,51 @@ void Game::update(float elapsed)
         bigArray(elapsed);          // Use Big Array ECS (existing)
 
 
-    // Collision handling for static entities.
-    Rectangle& playerBB = player->getBoundingBox();
+    // Collision handling for static entities. The contact list is this tick's
+    // only, so it lives in the frame arena; the grid holds last tick's cells.
+    FrameVector<Entity*> contacts;
+    contacts.reserve(16);
+    entityGrid.query(player->getBoundingBox(), contacts,
+        [](Entity* e) -> const Rectangle& { return e->getBoundingBox(); });
+    std::sort(contacts.begin(), contacts.end(),
+        [](const Entity* a, const Entity* b) { return a->getID() < b->getID(); });
+    for (Entity* ent : contacts) {
+        if (ent == player.get() || ent->isDeleted()) continue;
+        auto it = collisionCallbacks.find(ent->getEntityType());
+        if (it != collisionCallbacks.end()) {
+            it->second(ent);
+        }
+    }
+
+    // Loads chunks coming into range and marks entities of unloaded chunks deleted.
+    updateStreaming();
+    updateFlowField();
+    pathPlanner.update(*board, pathBudget);
+    // Everything published this tick reaches its subscribers here, in bulk.
+    events->dispatch();
+
+    // Keep the spatial grid and ECS storage in sync before dropping deleted entities.
     for (auto& ent : entities) {
-        if (ent == player) continue;
-        Rectangle& eBB = ent->getBoundingBox();
-        if (playerBB.intersects(eBB)) {
-            auto it = collisionCallbacks.find(ent->getEntityType());
-            if (it != collisionCallbacks.end()) {                    
-                it->second(ent.get());                               
-            }                                                       
-            
+        if (ent->isDeleted()) {
+            entityGrid.remove(ent.get());
+            // Entities removed before their TTL ran out take their timer with them.
+            if (auto ttl = ent->getTTLComponent())
+                cancelTimer(ttl->getTimer());
+            if (ecsType == ECSType::PACKED_ARRAY && packedEntities.contains(ent->getID()))
+                packedEntities.remove(ent->getID());
+            if (ent->getEntityType() == EntityType::FIRE)
+                firePool.release(static_cast<Fire*>(ent.get()));
+        }
+        else {
+            entityGrid.update(ent.get(), ent->getBoundingBox());
+        }
+    }
+    if (ecsType == ECSType::ARCHETYPES) {
+        for (auto& archetype : archetypes) {
+            archetype.entities.erase(
+                std::remove_if(archetype.entities.begin(), archetype.entities.end(),
+                    [](std::shared_ptr<Entity>& e) { return e->isDeleted(); }),
+                archetype.entities.end());
         }
     }
 
@@ -210,7 +554,14 @@ void Game::update(float elapsed)
         entities.end()
     );
 
-    window.update();
+    if (isHeadless()) return;
+    window->update();
+    if (window->consumeFullscreenToggle()) {
+        // Recreating the window needs its context back on this thread.
+        renderThread.stop();
+        window->toggleFullscreen();
+        renderThread.start();
+    }
 }
 
 // New updateArchetypes method (implementing Archetypes ECS logic)
@@ -240,13 +591,53 @@ void Game::updatePackedArray(float elapsed) {
 
 void Game::render(float elapsed)
 {
-    window.beginDraw();
-    if (board) { board->draw(&window); }
-    for (auto& ent : entities) {
-        ent->draw(&window);
+    RenderCommandList& commands = renderThread.getWriteList();
+    commands.clear();
+
+    if (player) {
+        const Rectangle& bb = player->getBoundingBox();
+        Vector2f center = (bb.getTopLeft() + bb.getBottomRight()) * 0.5f;
+        camera.follow(sf::Vector2f(center.x, center.y));
+    }
+    Rectangle viewRect = camera.getViewRect();
+    commands.setView(camera.getView());
+
+    board->draw(commands, viewRect);
+
+    visibleEntities.clear();
+    entityGrid.query(viewRect, visibleEntities,
+        [](Entity* e) -> const Rectangle& { return e->getBoundingBox(); });
+    // IDs follow creation order, which is the order entities were drawn in before culling.
+    std::sort(visibleEntities.begin(), visibleEntities.end(),
+        [](const Entity* a, const Entity* b) { return a->getID() < b->getID(); });
+    for (Entity* ent : visibleEntities) {
+        ent->draw(commands);
     }
-    window.drawGUI(*this);
-    window.endDraw();
+    particleSystem->draw(commands, viewRect);
+
+    commands.append(overlayCommands);
+    overlayCommands.clear();
+
+    HudState hud;
+    hud.fps = fps;
+    hud.paused = paused;
+    hud.hasPlayer = player != nullptr;
+    if (player) {
+        hud.health = player->getHealthComp()->getHealth();
+        hud.maxHealth = player->getHealthComp()->getMaxHealth();
+        hud.wood = player->getWood();
+    }
+    MemoryStats memory = MemoryTracker::get(MemoryTag::Total);
+    hud.memoryKiB = static_cast<int>(MemoryTracker::toKiB(memory.current));
+    hud.memoryBudgetKiB = memory.budget ? static_cast<int>(MemoryTracker::toKiB(memory.budget)) : -1;
+    commands.setScreenView();
+    commands.hud(hud);
+
+    if (recorder)
+        recorder->record(frameIndex, commands);
+    else
+        renderThread.publish();
+    frameIndex++;
 }
 
 sf::Time Game::getElapsed() const
@@ -254,22 +645,33 @@ sf::Time Game::getElapsed() const
     return gameClock.getElapsedTime();
 }
 
-void Game::setFPS(int fps)
+void Game::setFPS(int newFPS)
 {
+    fps = newFPS;
     std::cout << "FPS: " << fps << std::endl;
 }
 
 void Game::buildBoard(size_t width, size_t height)
 {
-    board = std::make_unique<Board>(width, height);
+    // Binary levels fix their own chunk size.
+    board = std::make_unique<Board>(width, height, levelStreamer ? levelStreamer->getChunkTiles() : chunkTiles);
+    // Revisions restart with the new board.
+    flowRequested = false;
+    pathPlanner.clear();
 }
 
 void Game::initWindow(size_t width, size_t height)
 {
-    int wdt = static_cast<int>(width * spriteWH * tileScale);
-    int hgt = static_cast<int>(height * spriteWH * tileScale);
-    window.setSize(sf::Vector2u(wdt, hgt));
-    window.redraw();
+    float worldW = width * spriteWH * tileScale;
+    float worldH = height * spriteWH * tileScale;
+    int wdt = std::min(static_cast<int>(worldW), maxWindowWidth);
+    int hgt = std::min(static_cast<int>(worldH), maxWindowHeight);
+    camera.setWorldSize(sf::Vector2f(worldW, worldH));
+    camera.setViewSize(sf::Vector2f(static_cast<float>(wdt), static_cast<float>(hgt)));
+    if (window) {
+        window->setSize(sf::Vector2u(wdt, hgt));
+        window->redraw();
+    }
 }
 
 EntityID Game::getIDCounter()
@@ -1,73 +1,97 @@
 #include "../../include/core/InputHandler.h"
 #include "../../include/core/Command.h"
-#include <SFML/Window/Keyboard.hpp>
-#include <vector> 
+#include "../../include/core/Game.h"
+#include <iostream>
 
 InputHandler::InputHandler()
+    : inputMode(InputMode::WASD) // Default to WASD
+    , reportedDrops(0)
 {
-    pauseCommand = std::make_shared<PauseCommand>();  // Initialize PauseCommand
-}
+    for (auto& table : bindings)
+        table.fill(-1);
 
-std::shared_ptr<Command> InputHandler::handleInput()
-{
+    bind(InputMode::WASD, sf::Keyboard::W, Action::MoveUp);
+    bind(InputMode::WASD, sf::Keyboard::A, Action::MoveLeft);
+    bind(InputMode::WASD, sf::Keyboard::S, Action::MoveDown);
+    bind(InputMode::WASD, sf::Keyboard::D, Action::MoveRight);
+    bind(InputMode::ARROWS, sf::Keyboard::Up, Action::MoveUp);
+    bind(InputMode::ARROWS, sf::Keyboard::Left, Action::MoveLeft);
+    bind(InputMode::ARROWS, sf::Keyboard::Down, Action::MoveDown);
+    bind(InputMode::ARROWS, sf::Keyboard::Right, Action::MoveRight);
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Escape))  // Check for Escape key
-    {
-        return pauseCommand;  // Return pause command when Escape is pressed
+    // Bindings common to both modes
+    for (InputMode mode : { InputMode::WASD, InputMode::ARROWS }) {
+        bind(mode, sf::Keyboard::Space, Action::Attack);
+        bind(mode, sf::Keyboard::LShift, Action::Shout);
+        bind(mode, sf::Keyboard::Escape, Action::Pause);
+        bind(mode, sf::Keyboard::Enter, Action::ToggleMode);
     }
-    return nullptr;
+
+    pauseCommand = std::make_unique<PauseCommand>();
 }
 
-PlayerInputHandler::PlayerInputHandler()
+void InputHandler::bind(InputMode mode, sf::Keyboard::Key key, Action action)
 {
-    moveRightCommand = std::make_shared<MoveRightCommand>();
-    moveLeftCommand = std::make_shared<MoveLeftCommand>();
-    moveUpCommand = std::make_shared<MoveUpCommand>();
-    moveDownCommand = std::make_shared<MoveDownCommand>();
-    attackCommand = std::make_shared<AttackCommand>();
-    shoutCommand = std::make_shared<ShoutCommand>();
-
-    inputMode = InputMode::WASD; // Default to WASD
+    if (key < 0 || key >= sf::Keyboard::KeyCount) return;
+    bindings[static_cast<int>(mode)][key] = static_cast<std::int8_t>(action);
 }
 
-std::vector<std::shared_ptr<Command>>& PlayerInputHandler::handleInput()
+ActionMask InputHandler::heldActions() const
 {
-    commandQueue.clear();
+    const Bindings& table = bindings[static_cast<int>(inputMode)];
+    ActionMask mask = 0;
+    for (int key = 0; key < sf::Keyboard::KeyCount; ++key) {
+        if (keysDown[key] && table[key] >= 0)
+            mask |= actionBit(static_cast<Action>(table[key]));
+    }
+    return mask;
+}
 
-    //Toggle input mode using Enter key (with debounce)
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Enter)) {
-        if (!togglePressed) {
-            toggleInputMode();
-            togglePressed = true;
+const ActionState& InputHandler::update(InputBuffer& buffer)
+{
+    const Bindings& table = bindings[static_cast<int>(inputMode)];
+    actions.pressed = 0;
+    actions.latency = sf::Time::Zero;
+
+    KeyEvent event;
+    bool first = true;
+    while (buffer.pop(event)) {
+        if (first) {
+            actions.latency = buffer.now() - event.time;
+            first = false;
         }
-    }
-    else {
-        togglePressed = false;
-    }
+        if (event.key == sf::Keyboard::Unknown) {
+            if (!event.pressed) keysDown.reset();
+            continue;
+        }
+        if (event.key < 0 || event.key >= sf::Keyboard::KeyCount) continue;
 
-    if (inputMode == InputMode::WASD) {
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) commandQueue.push_back(moveUpCommand);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) commandQueue.push_back(moveLeftCommand);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) commandQueue.push_back(moveDownCommand);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) commandQueue.push_back(moveRightCommand);
-    }
-    else if (inputMode == InputMode::ARROWS) {
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) commandQueue.push_back(moveUpCommand);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) commandQueue.push_back(moveLeftCommand);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) commandQueue.push_back(moveDownCommand);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) commandQueue.push_back(moveRightCommand);
+        // Repeated presses while held are not new presses.
+        if (event.pressed && !keysDown[event.key] && table[event.key] >= 0)
+            actions.pressed |= actionBit(static_cast<Action>(table[event.key]));
+        keysDown[event.key] = event.pressed;
     }
 
-    // Commands common to both modes
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) commandQueue.push_back(attackCommand); //attack command
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift)) commandQueue.push_back(shoutCommand); //shout command
+    if (buffer.getDropped() != reportedDrops) {
+        std::cout << "[InputHandler] Input buffer overflowed, released all keys ("
+                  << buffer.getDropped() - reportedDrops << " events dropped)\n";
+        reportedDrops = buffer.getDropped();
+    }
 
+    actions.held = heldActions();
+    return actions;
+}
 
-    return commandQueue;
+void InputHandler::dispatch(Game& game)
+{
+    if (actions.wasPressed(Action::Pause))
+        pauseCommand->execute(game);
+    if (actions.wasPressed(Action::ToggleMode))
+        toggleInputMode();
 }
 
 // Toggle between WASD and Arrow input modes
-void PlayerInputHandler::toggleInputMode() {
+void InputHandler::toggleInputMode() {
     if (inputMode == InputMode::WASD) {
         inputMode = InputMode::ARROWS;
         std::cout << "[InputHandler] Switched to ARROWS mode\n";
@@ -76,8 +100,30 @@ void PlayerInputHandler::toggleInputMode() {
         inputMode = InputMode::WASD;
         std::cout << "[InputHandler] Switched to WASD mode\n";
     }
+    // Keys still down now map through the other table.
+    actions.held = heldActions();
 }
 
-InputMode PlayerInputHandler::getInputMode() const {
+InputMode InputHandler::getInputMode() const {
     return inputMode;
-}
\ No newline at end of file
+}
+
+PlayerInputHandler::PlayerInputHandler()
+{
+    commands[static_cast<size_t>(Action::MoveUp)] = std::make_unique<MoveUpCommand>();
+    commands[static_cast<size_t>(Action::MoveLeft)] = std::make_unique<MoveLeftCommand>();
+    commands[static_cast<size_t>(Action::MoveDown)] = std::make_unique<MoveDownCommand>();
+    commands[static_cast<size_t>(Action::MoveRight)] = std::make_unique<MoveRightCommand>();
+    commands[static_cast<size_t>(Action::Attack)] = std::make_unique<AttackCommand>();
+    commands[static_cast<size_t>(Action::Shout)] = std::make_unique<ShoutCommand>();
+}
+
+void PlayerInputHandler::handleInput(const ActionState& actions, Game& game)
+{
+    // A tap that was pressed and released between ticks still counts for this tick.
+    ActionMask active = actions.held | actions.pressed;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        if (commands[i] && (active & actionBit(static_cast<Action>(i))))
+            commands[i]->execute(game);
+    }
+}
@@ -0,0 +1,137 @@
+#include "../../include/core/LevelGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+namespace {
+    // The standard distributions differ between library implementations;
+    // these only rely on mt19937's specified output.
+    double unit(std::mt19937& rng) {
+        return rng() / 4294967296.0;
+    }
+
+    int below(std::mt19937& rng, int n) {
+        return static_cast<int>(unit(rng) * n);
+    }
+
+    double gaussian(std::mt19937& rng) {
+        double u1 = std::max(unit(rng), 1e-12), u2 = unit(rng);
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+}
+
+bool LevelGenSettings::fromScenario(const std::string& name, LevelGenSettings& out) {
+    // Sized for roughly one entity per four floor cells.
+    if (name == "1k") { out.width = 72; out.height = 72; out.logs = out.potions = 500; }
+    else if (name == "100k") { out.width = 700; out.height = 700; out.logs = out.potions = 50000; }
+    else if (name == "1m") { out.width = 2200; out.height = 2200; out.logs = out.potions = 500000; }
+    else return false;
+    return true;
+}
+
+GeneratedLevel::GeneratedLevel(const LevelGenSettings& settings, int tiles) {
+    if (settings.width < 3 || settings.height < 3)
+        throw std::runtime_error("GeneratedLevel: level must be at least 3x3");
+    if (tiles <= 0) throw std::runtime_error("GeneratedLevel: chunk size must be positive");
+    width = settings.width;
+    height = settings.height;
+    chunkTiles = tiles;
+    cells.assign(width * height, '.');
+
+    std::mt19937 rng(settings.seed);
+
+    // Border walls, then random inner walls.
+    size_t freeCells = 0;
+    for (int y = 0; y < settings.height; y++) {
+        for (int x = 0; x < settings.width; x++) {
+            bool border = x == 0 || y == 0 || x == settings.width - 1 || y == settings.height - 1;
+            if (border || unit(rng) < settings.wallDensity)
+                cell(x, y) = 'w';
+            else
+                freeCells++;
+        }
+    }
+
+    // Player on the free cell nearest the centre, clearing one if needed.
+    int cx = settings.width / 2, cy = settings.height / 2;
+    sf::Vector2i best(cx, cy);
+    for (int r = 0; r < std::max(settings.width, settings.height); r++) {
+        bool found = false;
+        for (int y = std::max(1, cy - r); y <= std::min(settings.height - 2, cy + r) && !found; y++) {
+            for (int x = std::max(1, cx - r); x <= std::min(settings.width - 2, cx + r) && !found; x++) {
+                if (cell(x, y) == '.') { best = sf::Vector2i(x, y); found = true; }
+            }
+        }
+        if (found) break;
+    }
+    if (cell(best.x, best.y) == 'w') freeCells++;
+    cell(best.x, best.y) = '*';
+    freeCells--;
+    spawn = best;
+
+    size_t total = settings.logs + settings.potions + settings.enemies;
+    if (total > freeCells)
+        throw std::runtime_error("GeneratedLevel: " + std::to_string(total) + " entities do not fit in "
+            + std::to_string(freeCells) + " free cells");
+
+    std::vector<sf::Vector2i> centres;
+    if (settings.distribution == SpawnDistribution::CLUSTERED) {
+        for (int i = 0; i < std::max(1, settings.clusters); i++)
+            centres.emplace_back(below(rng, settings.width), below(rng, settings.height));
+    }
+
+    // Pick a target cell, then probe forward to the next free one so every
+    // placement terminates even on crowded maps.
+    size_t cellCount = cells.size();
+    auto place = [&](char type) {
+        int x, y;
+        if (centres.empty()) {
+            x = below(rng, settings.width);
+            y = below(rng, settings.height);
+        }
+        else {
+            const sf::Vector2i& c = centres[below(rng, static_cast<int>(centres.size()))];
+            x = std::clamp(static_cast<int>(std::lround(c.x + gaussian(rng) * settings.clusterRadius)), 0, settings.width - 1);
+            y = std::clamp(static_cast<int>(std::lround(c.y + gaussian(rng) * settings.clusterRadius)), 0, settings.height - 1);
+        }
+        size_t idx = static_cast<size_t>(y) * width + x;
+        while (cells[idx] != '.')
+            idx = (idx + 1) % cellCount;
+        cells[idx] = type;
+    };
+    for (size_t i = 0; i < settings.logs; i++) place('x');
+    for (size_t i = 0; i < settings.potions; i++) place('p');
+    for (size_t i = 0; i < settings.enemies; i++) place('e');
+}
+
+LevelChunk GeneratedLevel::readChunk(int cx, int cy) {
+    LevelChunk chunk = makeChunk(cx, cy);
+    for (int y = 0; y < chunk.height; y++) {
+        decodeRow(&cells[static_cast<size_t>(chunk.originY + y) * width + chunk.originX], chunk.width,
+            chunk.originX, chunk.originY + y, &chunk.tiles[static_cast<size_t>(y) * chunk.width], chunk.spawns);
+    }
+    return chunk;
+}
+
+void GeneratedLevel::writeText(const std::string& file) const {
+    std::string tempFile = LevelSource::tempFileFor(file);
+    std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot write level: " + tempFile);
+    for (size_t y = 0; y < height; y++) {
+        out.write(&cells[y * width], width);
+        out.put('\n');
+    }
+    out.close();
+    if (!out) throw std::runtime_error("Failed writing level: " + tempFile);
+    LevelSource::replaceFile(tempFile, file);
+}
+
+void GeneratedLevel::save(const std::string& file) {
+    const std::string ext = LevelFile::extension;
+    if (file.size() >= ext.size() && file.compare(file.size() - ext.size(), ext.size(), ext) == 0)
+        LevelSource::writeBinary(*this, file);
+    else
+        writeText(file);
+}
@@ -0,0 +1,269 @@
+#include "../../include/core/LevelSource.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace {
+    bool endsWith(const std::string& s, const std::string& suffix) {
+        return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    template<typename T>
+    void writePod(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // Whether count items of itemSize bytes at offset lie inside the file.
+    // Written so a corrupt header cannot overflow its way past the check.
+    bool inFile(uint64_t offset, uint64_t count, uint64_t itemSize, uint64_t fileSize) {
+        if (count > fileSize / itemSize) return false;
+        uint64_t bytes = count * itemSize;
+        return bytes <= fileSize && offset <= fileSize - bytes;
+    }
+}
+
+std::unique_ptr<LevelSource> LevelSource::open(const std::string& file, int chunkTiles) {
+    if (endsWith(file, LevelFile::extension))
+        return std::make_unique<BinaryLevelSource>(file);
+    return std::make_unique<TextLevelSource>(file, chunkTiles);
+}
+
+LevelChunk LevelSource::makeChunk(int cx, int cy) const {
+    LevelChunk chunk;
+    chunk.cx = cx;
+    chunk.cy = cy;
+    chunk.originX = cx * chunkTiles;
+    chunk.originY = cy * chunkTiles;
+    chunk.width = std::max(0, std::min(chunkTiles, static_cast<int>(width) - chunk.originX));
+    chunk.height = std::max(0, std::min(chunkTiles, static_cast<int>(height) - chunk.originY));
+    chunk.tiles.assign(static_cast<size_t>(chunk.width) * chunk.height, LevelTile::NONE);
+    return chunk;
+}
+
+void LevelSource::decodeRow(const char* cells, int count, int levelX, int levelY,
+                            LevelTile* tiles, std::vector<LevelSpawn>& spawns) {
+    for (int x = 0; x < count; x++) {
+        switch (cells[x])
+        {
+            case '.':
+            case '*':
+                tiles[x] = LevelTile::CORRIDOR;
+                break;
+            case 'w':
+                tiles[x] = LevelTile::WALL;
+                break;
+            case 'x':
+                tiles[x] = LevelTile::CORRIDOR;
+                spawns.push_back({ levelX + x, levelY, SpawnType::LOG, {} });
+                break;
+            case 'p':
+                tiles[x] = LevelTile::CORRIDOR;
+                spawns.push_back({ levelX + x, levelY, SpawnType::POTION, {} });
+                break;
+            case 'e':
+                tiles[x] = LevelTile::CORRIDOR;
+                spawns.push_back({ levelX + x, levelY, SpawnType::ENEMY, {} });
+                break;
+        }
+    }
+}
+
+// ---------------------------------------------------------------- Text
+
+TextLevelSource::TextLevelSource(const std::string& file, int tiles)
+    : in(file, std::ios::binary)
+{
+    if (tiles <= 0) throw std::runtime_error("TextLevelSource: chunk size must be positive");
+    if (!in) throw std::runtime_error("Level file not found: " + file);
+    chunkTiles = tiles;
+
+    std::string line;
+    std::streamoff offset = 0;
+    while (std::getline(in, line)) {
+        std::streamoff next = offset + static_cast<std::streamoff>(line.size()) + 1;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) {
+            offset = next;
+            continue;
+        }
+        // As before, the first row sets the level width.
+        if (rows.empty()) width = line.size();
+        size_t p = line.find('*');
+        if (p != std::string::npos && !hasSpawn())
+            spawn = sf::Vector2i(static_cast<int>(p), static_cast<int>(rows.size()));
+        rows.push_back({ offset, static_cast<int>(line.size()) });
+        offset = next;
+    }
+    if (rows.empty()) throw std::runtime_error("No data in level file: " + file);
+    height = rows.size();
+}
+
+LevelChunk TextLevelSource::readChunk(int cx, int cy) {
+    LevelChunk chunk = makeChunk(cx, cy);
+
+    std::string cells(chunk.width, ' ');
+    for (int y = 0; y < chunk.height; y++) {
+        const RowSpan& row = rows[chunk.originY + y];
+        int count = std::min(chunk.width, row.length - chunk.originX);
+        if (count <= 0) continue;
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            in.clear();
+            in.seekg(row.offset + chunk.originX);
+            in.read(&cells[0], count);
+        }
+        decodeRow(cells.data(), count, chunk.originX, chunk.originY + y,
+            &chunk.tiles[static_cast<size_t>(y) * chunk.width], chunk.spawns);
+    }
+    return chunk;
+}
+
+// ---------------------------------------------------------------- Binary
+
+BinaryLevelSource::BinaryLevelSource(const std::string& file)
+    : chunkTable(nullptr), spawnTable(nullptr)
+{
+    mapping.open(file);
+    const unsigned char* base = mapping.data();
+    size_t size = mapping.size();
+
+    if (size < sizeof(LevelFile::Header))
+        throw std::runtime_error("Binary level too small: " + file);
+    const auto* header = reinterpret_cast<const LevelFile::Header*>(base);
+    if (std::memcmp(header->magic, LevelFile::magic, 4) != 0 || header->version != LevelFile::version)
+        throw std::runtime_error("Not a version " + std::to_string(LevelFile::version) + " binary level: " + file);
+
+    width = header->width;
+    height = header->height;
+    chunkTiles = static_cast<int>(header->chunkTiles);
+    spawn = sf::Vector2i(header->spawnX, header->spawnY);
+    if (chunkTiles <= 0 || width == 0 || height == 0
+        || header->chunksX != static_cast<uint32_t>(getChunksX())
+        || header->chunksY != static_cast<uint32_t>(getChunksY()))
+        throw std::runtime_error("Corrupt binary level header: " + file);
+
+    // Bounds-check the tables once so readChunk can index without checks.
+    uint64_t chunkCount = static_cast<uint64_t>(header->chunksX) * header->chunksY;
+    uint64_t chunkBytes = static_cast<uint64_t>(chunkTiles) * chunkTiles;
+    if (!inFile(header->chunkTableOffset, chunkCount, sizeof(LevelFile::ChunkEntry), size)
+        || !inFile(header->spawnTableOffset, header->spawnCount, sizeof(LevelSpawn), size)
+        || !inFile(header->tileDataOffset, chunkCount, chunkBytes, size))
+        throw std::runtime_error("Truncated binary level: " + file);
+
+    chunkTable = reinterpret_cast<const LevelFile::ChunkEntry*>(base + header->chunkTableOffset);
+    spawnTable = reinterpret_cast<const LevelSpawn*>(base + header->spawnTableOffset);
+    for (uint64_t i = 0; i < chunkCount; i++) {
+        const LevelFile::ChunkEntry& entry = chunkTable[i];
+        if (!inFile(entry.tileOffset, 1, chunkBytes, size)
+            || entry.spawnCount > header->spawnCount
+            || entry.firstSpawn > header->spawnCount - entry.spawnCount)
+            throw std::runtime_error("Corrupt binary level chunk table: " + file);
+    }
+}
+
+LevelChunk BinaryLevelSource::readChunk(int cx, int cy) {
+    LevelChunk chunk;
+    chunk.cx = cx;
+    chunk.cy = cy;
+    chunk.originX = cx * chunkTiles;
+    chunk.originY = cy * chunkTiles;
+    if (cx < 0 || cy < 0 || cx >= getChunksX() || cy >= getChunksY())
+        return chunk;
+    chunk.width = std::min(chunkTiles, static_cast<int>(width) - chunk.originX);
+    chunk.height = std::min(chunkTiles, static_cast<int>(height) - chunk.originY);
+
+    const LevelFile::ChunkEntry& entry = chunkTable[cy * getChunksX() + cx];
+    const auto* tiles = reinterpret_cast<const LevelTile*>(mapping.data() + entry.tileOffset);
+    chunk.tiles.resize(static_cast<size_t>(chunk.width) * chunk.height);
+    for (int y = 0; y < chunk.height; y++)
+        std::memcpy(&chunk.tiles[static_cast<size_t>(y) * chunk.width], tiles + y * chunkTiles, chunk.width);
+    chunk.spawns.assign(spawnTable + entry.firstSpawn, spawnTable + entry.firstSpawn + entry.spawnCount);
+    return chunk;
+}
+
+// ---------------------------------------------------------------- Converter
+
+void LevelSource::replaceFile(const std::string& tempFile, const std::string& file) {
+    std::error_code ec, ignored;
+    std::filesystem::rename(tempFile, file, ec);
+    if (ec && std::filesystem::exists(file, ignored)) {
+        // A mapped file can be renamed but not replaced on Windows. An .old
+        // left by an earlier replace goes now if its reader has let go.
+        std::string oldFile = file + ".old";
+        std::filesystem::remove(oldFile, ignored);
+        std::error_code aside;
+        std::filesystem::rename(file, oldFile, aside);
+        if (!aside) {
+            std::filesystem::rename(tempFile, file, ec);
+            if (ec)
+                std::filesystem::rename(oldFile, file, ignored);
+            else
+                std::filesystem::remove(oldFile, ignored);
+        }
+    }
+    if (ec) {
+        std::filesystem::remove(tempFile, ignored);
+        throw std::runtime_error("Cannot replace level " + file + ": " + ec.message());
+    }
+}
+
+void LevelSource::writeBinary(LevelSource& source, const std::string& file) {
+    std::string tempFile = tempFileFor(file);
+    std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot write binary level: " + tempFile);
+
+    int chunksX = source.getChunksX(), chunksY = source.getChunksY();
+    int tiles = source.getChunkTiles();
+    size_t chunkCount = static_cast<size_t>(chunksX) * chunksY;
+    size_t chunkBytes = static_cast<size_t>(tiles) * tiles;
+
+    // Spawns are gathered first since the header needs their count.
+    std::vector<LevelFile::ChunkEntry> table(chunkCount);
+    std::vector<LevelSpawn> spawns;
+    for (int cy = 0; cy < chunksY; cy++) {
+        for (int cx = 0; cx < chunksX; cx++) {
+            LevelChunk chunk = source.readChunk(cx, cy);
+            LevelFile::ChunkEntry& entry = table[cy * chunksX + cx];
+            entry.firstSpawn = static_cast<uint32_t>(spawns.size());
+            entry.spawnCount = static_cast<uint32_t>(chunk.spawns.size());
+            spawns.insert(spawns.end(), chunk.spawns.begin(), chunk.spawns.end());
+        }
+    }
+
+    LevelFile::Header header = {};
+    std::memcpy(header.magic, LevelFile::magic, 4);
+    header.version = LevelFile::version;
+    header.width = static_cast<uint32_t>(source.getWidth());
+    header.height = static_cast<uint32_t>(source.getHeight());
+    header.chunkTiles = static_cast<uint32_t>(tiles);
+    header.chunksX = static_cast<uint32_t>(chunksX);
+    header.chunksY = static_cast<uint32_t>(chunksY);
+    header.spawnX = source.getSpawn().x;
+    header.spawnY = source.getSpawn().y;
+    header.spawnCount = static_cast<uint32_t>(spawns.size());
+    header.chunkTableOffset = sizeof(LevelFile::Header);
+    header.spawnTableOffset = header.chunkTableOffset + chunkCount * sizeof(LevelFile::ChunkEntry);
+    header.tileDataOffset = header.spawnTableOffset + spawns.size() * sizeof(LevelSpawn);
+    for (size_t i = 0; i < chunkCount; i++)
+        table[i].tileOffset = header.tileDataOffset + i * chunkBytes;
+
+    writePod(out, header);
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(LevelFile::ChunkEntry));
+    out.write(reinterpret_cast<const char*>(spawns.data()), spawns.size() * sizeof(LevelSpawn));
+
+    // Second pass streams the tile blocks, one padded square per chunk.
+    std::vector<LevelTile> block(chunkBytes);
+    for (int cy = 0; cy < chunksY; cy++) {
+        for (int cx = 0; cx < chunksX; cx++) {
+            LevelChunk chunk = source.readChunk(cx, cy);
+            std::fill(block.begin(), block.end(), LevelTile::NONE);
+            for (int y = 0; y < chunk.height; y++)
+                std::copy_n(&chunk.tiles[static_cast<size_t>(y) * chunk.width], chunk.width, &block[static_cast<size_t>(y) * tiles]);
+            out.write(reinterpret_cast<const char*>(block.data()), block.size());
+        }
+    }
+    out.close();
+    if (!out) throw std::runtime_error("Failed writing binary level: " + tempFile);
+    replaceFile(tempFile, file);
+}
@@ -0,0 +1,73 @@
+#include "../../include/core/LevelStreamer.h"
+#include <stdexcept>
+
+LevelStreamer::LevelStreamer(int tiles)
+    : chunkTiles(tiles), running(false)
+{
+}
+
+LevelStreamer::~LevelStreamer() {
+    stop();
+}
+
+void LevelStreamer::open(const std::string& file) {
+    stop();
+    source = LevelSource::open(file, chunkTiles);
+}
+
+void LevelStreamer::start() {
+    if (running || !source) return;
+    running = true;
+    worker = std::thread(&LevelStreamer::run, this);
+}
+
+void LevelStreamer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        running = false;
+    }
+    wakeUp.notify_one();
+    if (worker.joinable())
+        worker.join();
+}
+
+void LevelStreamer::request(int cx, int cy) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.push_back(sf::Vector2i(cx, cy));
+    }
+    wakeUp.notify_one();
+}
+
+void LevelStreamer::poll(std::vector<LevelChunk>& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& chunk : finished)
+        out.push_back(std::move(chunk));
+    finished.clear();
+}
+
+void LevelStreamer::run() {
+    while (true) {
+        sf::Vector2i next;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return !running || !requests.empty(); });
+            if (!running) return;
+            next = requests.front();
+            requests.pop_front();
+        }
+        LevelChunk chunk;
+        try {
+            chunk = source->readChunk(next.x, next.y);
+        }
+        catch (const std::exception& e) {
+            chunk = LevelChunk();
+            chunk.cx = next.x;
+            chunk.cy = next.y;
+            chunk.error = e.what();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.push_back(std::move(chunk));
+    }
+}
@@ -0,0 +1,332 @@
+#include "../../include/core/PathPlanner.h"
+#include "../../include/core/Board.h"
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+    // East, west, south, north; also the bit order of Entrance::sides.
+    const int sideOffsets[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    // Border runs at least this long get an entrance at each end instead of one in the middle.
+    const int longRun = 6;
+
+    bool walkableAt(const Board& board, int x, int y) {
+        const Tile* tile = board.getTile(x, y);
+        return tile && tile->getType() == TileType::CORRIDOR;
+    }
+}
+
+PathPlanner::PathPlanner() : clusterTiles(0), nextID(1), frame(0) {}
+
+void PathPlanner::clear() {
+    clusters.clear();
+}
+
+PathRequestID PathPlanner::request(const sf::Vector2i& start, const sf::Vector2i& goal) {
+    PathRequestID id = nextID++;
+    if (nextID == 0) nextID = 1;
+    jobs.push_back({ id, start, goal });
+    results[id] = { Status::Pending, frame, {} };
+    return id;
+}
+
+void PathPlanner::update(const Board& board, sf::Time budget) {
+    frame++;
+    sf::Clock clock;
+    while (!jobs.empty()) {
+        Job job = jobs.front();
+        jobs.pop_front();
+        Result& result = results[job.id];
+        result.status = findPath(board, job.start, job.goal, result.path) ? Status::Found : Status::NotFound;
+        result.frame = frame;
+        if (clock.getElapsedTime() >= budget) break;
+    }
+
+    for (auto it = results.begin(); it != results.end();) {
+        if (it->second.status != Status::Pending && frame - it->second.frame > resultLifetime)
+            it = results.erase(it);
+        else
+            ++it;
+    }
+}
+
+PathPlanner::Status PathPlanner::takeResult(PathRequestID id, std::vector<sf::Vector2i>& path) {
+    auto it = results.find(id);
+    if (it == results.end()) return Status::Unknown;
+    Status status = it->second.status;
+    if (status == Status::Pending) return status;
+    path = std::move(it->second.path);
+    results.erase(it);
+    return status;
+}
+
+const PathPlanner::Cluster* PathPlanner::getCluster(const Board& board, int cx, int cy) {
+    GridKey key = makeGridKey(cx, cy);
+    std::uint64_t stamp = board.getChunkStamp(cx, cy);
+    if (stamp == 0) {
+        clusters.erase(key);
+        return nullptr;
+    }
+
+    Cluster& cluster = clusters[key];
+    bool valid = cluster.stamp == stamp;
+    for (int side = 0; side < 4 && valid; side++)
+        valid = cluster.neighbourStamps[side] == board.getChunkStamp(cx + sideOffsets[side][0], cy + sideOffsets[side][1]);
+    if (!valid) {
+        cluster.cx = cx;
+        cluster.cy = cy;
+        buildCluster(board, cluster);
+    }
+    return &cluster;
+}
+
+void PathPlanner::buildCluster(const Board& board, Cluster& cluster) {
+    const int tiles = clusterTiles;
+    int ox = cluster.cx * tiles, oy = cluster.cy * tiles;
+    cluster.stamp = board.getChunkStamp(cluster.cx, cluster.cy);
+    cluster.walkable.assign(static_cast<size_t>(tiles) * tiles, 0);
+    for (int y = 0; y < tiles; y++) {
+        for (int x = 0; x < tiles; x++)
+            cluster.walkable[y * tiles + x] = walkableAt(board, ox + x, oy + y);
+    }
+
+    cluster.entrances.clear();
+    auto addEntrance = [&cluster](int cell, int side) {
+        for (Entrance& e : cluster.entrances) {
+            if (e.cell == cell) {
+                e.sides |= 1 << side;
+                return;
+            }
+        }
+        cluster.entrances.push_back({ cell, static_cast<std::uint8_t>(1 << side) });
+    };
+
+    // Entrances sit on runs of border cells that are open on both sides. Both
+    // clusters scan the same border in world coordinates, so they agree on them.
+    for (int side = 0; side < 4; side++) {
+        int dx = sideOffsets[side][0], dy = sideOffsets[side][1];
+        cluster.neighbourStamps[side] = board.getChunkStamp(cluster.cx + dx, cluster.cy + dy);
+        if (cluster.neighbourStamps[side] == 0) continue;
+
+        auto borderCell = [&](int k) {
+            switch (side) {
+                case 0: return k * tiles + (tiles - 1);
+                case 1: return k * tiles;
+                case 2: return (tiles - 1) * tiles + k;
+                default: return k;
+            }
+        };
+        int runStart = -1;
+        for (int k = 0; k <= tiles; k++) {
+            bool open = false;
+            if (k < tiles) {
+                int cell = borderCell(k);
+                open = cluster.walkable[cell] && walkableAt(board, ox + cell % tiles + dx, oy + cell / tiles + dy);
+            }
+            if (open && runStart < 0) {
+                runStart = k;
+            }
+            else if (!open && runStart >= 0) {
+                int runEnd = k - 1;
+                if (runEnd - runStart + 1 >= longRun) {
+                    addEntrance(borderCell(runStart), side);
+                    addEntrance(borderCell(runEnd), side);
+                }
+                else {
+                    addEntrance(borderCell((runStart + runEnd) / 2), side);
+                }
+                runStart = -1;
+            }
+        }
+    }
+
+    // Cache the path between every pair of entrances.
+    size_t count = cluster.entrances.size();
+    cluster.costs.assign(count * count, -1);
+    cluster.paths.assign(count * count, std::vector<std::int32_t>());
+    for (size_t i = 0; i < count; i++) {
+        flood(cluster, cluster.entrances[i].cell, buildDist, buildParent);
+        for (size_t j = 0; j < count; j++) {
+            int target = cluster.entrances[j].cell;
+            if (buildDist[target] < 0) continue;
+            cluster.costs[i * count + j] = buildDist[target];
+            std::vector<std::int32_t>& path = cluster.paths[i * count + j];
+            for (int cell = target; cell != cluster.entrances[i].cell; cell = buildParent[cell])
+                path.push_back(cell);
+            std::reverse(path.begin(), path.end());
+        }
+    }
+}
+
+int PathPlanner::entranceIndex(const Cluster& cluster, int cell) const {
+    for (size_t i = 0; i < cluster.entrances.size(); i++) {
+        if (cluster.entrances[i].cell == cell) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void PathPlanner::flood(const Cluster& cluster, int from, std::vector<std::int32_t>& dist, std::vector<std::int32_t>& parent) {
+    const int tiles = clusterTiles;
+    dist.assign(cluster.walkable.size(), -1);
+    parent.assign(cluster.walkable.size(), -1);
+    std::vector<std::int32_t>& queue = floodQueue;
+    queue.clear();
+    dist[from] = 0;
+    queue.push_back(from);
+    for (size_t head = 0; head < queue.size(); head++) {
+        int cell = queue[head];
+        int x = cell % tiles, y = cell / tiles;
+        for (const auto& offset : sideOffsets) {
+            int nx = x + offset[0], ny = y + offset[1];
+            if (nx < 0 || ny < 0 || nx >= tiles || ny >= tiles) continue;
+            int next = ny * tiles + nx;
+            if (!cluster.walkable[next] || dist[next] >= 0) continue;
+            dist[next] = dist[cell] + 1;
+            parent[next] = cell;
+            queue.push_back(next);
+        }
+    }
+}
+
+sf::Vector2i PathPlanner::toWorld(const Cluster& cluster, int cell) const {
+    return sf::Vector2i(cluster.cx * clusterTiles + cell % clusterTiles, cluster.cy * clusterTiles + cell / clusterTiles);
+}
+
+bool PathPlanner::findPath(const Board& board, const sf::Vector2i& start, const sf::Vector2i& goal, std::vector<sf::Vector2i>& path) {
+    path.clear();
+    if (clusterTiles != board.getChunkTiles()) {
+        clusters.clear();
+        clusterTiles = board.getChunkTiles();
+    }
+    const int tiles = clusterTiles;
+    if (!board.inBounds(start.x, start.y) || !board.inBounds(goal.x, goal.y)) return false;
+
+    const Cluster* startCluster = getCluster(board, start.x / tiles, start.y / tiles);
+    const Cluster* goalCluster = getCluster(board, goal.x / tiles, goal.y / tiles);
+    if (!startCluster || !goalCluster) return false;
+    int startCell = (start.y % tiles) * tiles + start.x % tiles;
+    int goalCell = (goal.y % tiles) * tiles + goal.x % tiles;
+    if (!startCluster->walkable[startCell] || !goalCluster->walkable[goalCell]) return false;
+    if (start == goal) return true;
+
+    flood(*startCluster, startCell, startDist, startParent);
+    flood(*goalCluster, goalCell, goalDist, goalParent);
+
+    // Best complete path so far: straight through the shared cluster, or via an entrance of the goal cluster.
+    std::int32_t best = INT_MAX;
+    GridKey bestVia = 0;
+    bool direct = false;
+    if (startCluster == goalCluster && startDist[goalCell] >= 0) {
+        best = startDist[goalCell];
+        direct = true;
+    }
+
+    nodes.clear();
+    open = decltype(open)();
+    auto heuristic = [&goal](int x, int y) { return std::abs(x - goal.x) + std::abs(y - goal.y); };
+    auto relax = [&](int x, int y, std::int32_t g, GridKey parent, bool fromStart) {
+        GridKey key = makeGridKey(x, y);
+        auto inserted = nodes.try_emplace(key, Node{ g, parent, fromStart, false });
+        if (!inserted.second) {
+            Node& node = inserted.first->second;
+            if (node.closed || node.g <= g) return;
+            node = Node{ g, parent, fromStart, false };
+        }
+        open.push({ g + heuristic(x, y), key });
+    };
+
+    for (const Entrance& e : startCluster->entrances) {
+        if (startDist[e.cell] < 0) continue;
+        sf::Vector2i cell = toWorld(*startCluster, e.cell);
+        relax(cell.x, cell.y, startDist[e.cell], 0, true);
+    }
+
+    while (!open.empty()) {
+        std::pair<std::int32_t, GridKey> top = open.top();
+        open.pop();
+        if (top.first >= best) break;
+        Node& node = nodes[top.second];
+        if (node.closed) continue;
+        node.closed = true;
+        std::int32_t g = node.g;
+
+        int x = static_cast<int>(top.second >> 32);
+        int y = static_cast<int>(static_cast<unsigned int>(top.second));
+        const Cluster* cluster = getCluster(board, x / tiles, y / tiles);
+        int local = (y % tiles) * tiles + x % tiles;
+        int index = entranceIndex(*cluster, local);
+
+        if (cluster == goalCluster && goalDist[local] >= 0 && g + goalDist[local] < best) {
+            best = g + goalDist[local];
+            bestVia = top.second;
+            direct = false;
+        }
+
+        size_t count = cluster->entrances.size();
+        for (size_t j = 0; j < count; j++) {
+            std::int32_t cost = cluster->costs[index * count + j];
+            if (static_cast<int>(j) == index || cost < 0) continue;
+            sf::Vector2i cell = toWorld(*cluster, cluster->entrances[j].cell);
+            relax(cell.x, cell.y, g + cost, top.second, false);
+        }
+        for (int side = 0; side < 4; side++) {
+            if (!(cluster->entrances[index].sides & (1 << side))) continue;
+            int nx = x + sideOffsets[side][0], ny = y + sideOffsets[side][1];
+            const Cluster* neighbour = getCluster(board, nx / tiles, ny / tiles);
+            if (!neighbour || entranceIndex(*neighbour, (ny % tiles) * tiles + nx % tiles) < 0) continue;
+            relax(nx, ny, g + 1, top.second, false);
+        }
+    }
+    if (best == INT_MAX) return false;
+
+    if (direct) {
+        for (int cell = goalCell; cell != startCell; cell = startParent[cell])
+            path.push_back(toWorld(*startCluster, cell));
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
+
+    chain.clear();
+    for (GridKey key = bestVia;; key = nodes[key].parent) {
+        chain.push_back(key);
+        if (nodes[key].fromStart) break;
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    auto localOf = [tiles](GridKey key) {
+        int x = static_cast<int>(key >> 32), y = static_cast<int>(static_cast<unsigned int>(key));
+        return (y % tiles) * tiles + x % tiles;
+    };
+    auto clusterOf = [&](GridKey key) {
+        int x = static_cast<int>(key >> 32), y = static_cast<int>(static_cast<unsigned int>(key));
+        return getCluster(board, x / tiles, y / tiles);
+    };
+
+    // Start to the first entrance, then cached intra-cluster paths and border
+    // crossings, then the last entrance to the goal.
+    for (int cell = localOf(chain.front()); cell != startCell; cell = startParent[cell])
+        path.push_back(toWorld(*startCluster, cell));
+    std::reverse(path.begin(), path.end());
+
+    for (size_t k = 1; k < chain.size(); k++) {
+        const Cluster* from = clusterOf(chain[k - 1]);
+        const Cluster* to = clusterOf(chain[k]);
+        if (from == to) {
+            size_t count = from->entrances.size();
+            int i = entranceIndex(*from, localOf(chain[k - 1]));
+            int j = entranceIndex(*from, localOf(chain[k]));
+            for (int cell : from->paths[i * count + j])
+                path.push_back(toWorld(*from, cell));
+        }
+        else {
+            path.push_back(toWorld(*to, localOf(chain[k])));
+        }
+    }
+
+    for (int cell = localOf(chain.back()); cell != goalCell;) {
+        cell = goalParent[cell];
+        path.push_back(toWorld(*goalCluster, cell));
+    }
+    return true;
+}
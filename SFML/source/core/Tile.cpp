@@ -1,25 +1,18 @@
 #include "../../include/core/Tile.h"
-#include "../../include/graphics/Window.h"
+#include "../../include/graphics/RenderCommands.h"
 #include "../../include/graphics/TileTexture.h"
+#include <stdexcept>
 
-Tile::Tile(TileType t) : type(t) {}
+Tile::Tile(TileType t, std::shared_ptr<TileTexture> sharedTex, float sc)
+    : type(t), texture(sharedTex), scale(sc, sc)
+{
+    if (!texture) throw std::runtime_error("Tile: texture not provided");
 
-void Tile::loadTile(int x, int y, float sc, std::shared_ptr<TileTexture> sharedTex) {
-    position.x = x;
-    position.y = y;
-    texture = sharedTex;
-
-    if (!texture) throw std::runtime_error("Tile::loadTile: texture not provided");
-
-    sprite.setTexture(texture->getTexture());
-    sprite.setScale(sc, sc);
-
-    sf::Vector2u textSize = texture->getTexture().getSize();
-    float px = static_cast<float>(x * (textSize.x * sc));
-    float py = static_cast<float>(y * (textSize.y * sc));
-    sprite.setPosition(px, py);
+    sf::Vector2u textSize = texture->getSize();
+    textureRect = sf::IntRect(0, 0, static_cast<int>(textSize.x), static_cast<int>(textSize.y));
+    size = textSize.x * sc;
 }
 
-void Tile::draw(Window* window) {
-    window->draw(sprite);
+void Tile::draw(RenderCommandList& commands, int x, int y) const {
+    commands.quad(texture->getTexture(), textureRect, sf::Vector2f(x * size, y * size), scale);
 }
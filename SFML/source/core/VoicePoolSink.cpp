@@ -0,0 +1,122 @@
+#include "../../include/core/VoicePoolSink.h"
+#include <iostream>
+#include <stdexcept>
+
+VoicePoolSink::VoicePoolSink(std::shared_ptr<AssetLoader> assetLoader) : loader(assetLoader) {}
+
+SoundID VoicePoolSink::loadSound(const std::string& name, const std::string& filepath, const SoundSettings& settings) {
+    SoundID id = hashSoundName(name.c_str());
+    auto found = soundIndex.find(id);
+    if (found != soundIndex.end() && sounds[found->second].name != name)
+        throw std::runtime_error("[Audio] Sound ID collision: " + name + " and " + sounds[found->second].name);
+
+    SoundEntry entry;
+    entry.name = name;
+    entry.file = filepath;
+    entry.settings = settings;
+    entry.lastPlayed = -settings.cooldown;
+    if (loader) {
+        entry.pending = loader->requestSound(filepath);
+    }
+    else {
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        if (!buffer->loadFromFile(filepath)) {
+            std::cerr << "[Audio] Failed to load: " << filepath << "\n";
+            return id;
+        }
+        setBuffer(entry, buffer);
+    }
+
+    if (found != soundIndex.end()) {
+        sounds[found->second] = entry;
+    }
+    else {
+        soundIndex[id] = sounds.size();
+        sounds.push_back(entry);
+    }
+    return id;
+}
+
+void VoicePoolSink::resolve(SoundEntry& entry) {
+    if (!entry.pending.valid()) return;
+    AssetLoader::SoundHandle handle = entry.pending;
+    entry.pending = AssetLoader::SoundHandle();
+    // The entry keeps the buffer; the loader need not.
+    loader->release(entry.file);
+    try {
+        setBuffer(entry, handle.get());
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[Audio] " << e.what() << "\n";
+    }
+}
+
+void VoicePoolSink::setBuffer(SoundEntry& entry, std::shared_ptr<const sf::SoundBuffer> buffer) {
+    entry.buffer = buffer;
+    entry.memory.reset();
+    if (buffer)
+        entry.memory = std::make_shared<MemoryCharge>(MemoryTag::Audio, buffer->getSampleCount() * sizeof(sf::Int16));
+}
+
+void VoicePoolSink::finishLoading() {
+    for (auto& entry : sounds)
+        resolve(entry);
+}
+
+VoicePoolSink::Voice* VoicePoolSink::pickVoice(int priority) {
+    Voice* victim = nullptr;
+    for (auto& voice : voices) {
+        if (voice.sound.getStatus() == sf::SoundSource::Stopped)
+            return &voice;
+        if (voice.priority > priority)
+            continue;
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority && voice.startTime < victim->startTime))
+            victim = &voice;
+    }
+    return victim;
+}
+
+void VoicePoolSink::play(SoundID id) {
+    auto found = soundIndex.find(id);
+    if (found == soundIndex.end()) return;
+    SoundEntry& entry = sounds[found->second];
+    resolve(entry);
+    if (!entry.buffer) return;
+
+    float now = clock.getElapsedTime().asSeconds();
+    if (now - entry.lastPlayed < entry.settings.cooldown)
+        return;
+
+    Voice* voice = pickVoice(entry.settings.priority);
+    if (!voice) return;
+    entry.lastPlayed = now;
+    voice->sound.stop();
+    voice->sound.setBuffer(*entry.buffer);
+    voice->sound.setVolume(entry.settings.volume);
+    voice->id = id;
+    voice->priority = entry.settings.priority;
+    voice->startTime = now;
+    voice->sound.play();
+}
+
+void VoicePoolSink::stop(SoundID id) {
+    for (auto& voice : voices) {
+        if (voice.id == id)
+            voice.sound.stop();
+    }
+}
+
+void VoicePoolSink::stopAll() {
+    for (auto& voice : voices)
+        voice.sound.stop();
+}
+
+size_t VoicePoolSink::getActiveVoices() const {
+    size_t active = 0;
+    for (const auto& voice : voices) {
+        if (voice.sound.getStatus() != sf::SoundSource::Stopped)
+            active++;
+    }
+    return active;
+}
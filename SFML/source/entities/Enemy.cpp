@@ -0,0 +1,102 @@
+#include "../../include/entities/Enemy.h"
+#include "../../include/entities/StaticEntities.h"
+#include "../../include/core/Game.h"
+#include <cmath>
+
+Enemy::Enemy()
+    : Entity(EntityType::ENEMY),
+    pathRequest(0),
+    pathIndex(0),
+    wanderDelay(0.f),
+    wanderSeed(0)
+{
+    velocity = makeTracked<VelocityComponent>(MemoryTag::Components, speed);
+    addComponent(velocity);
+}
+
+Enemy::~Enemy() {}
+
+void Enemy::init(const std::string& textureFile, float scale) {
+    Entity::init(textureFile, scale);
+    // Place the bounding box now so the spatial grid files it correctly before the first update.
+    sf::Vector2f pos = getPosition();
+    boundingBox.setTopLeft(toCustom(pos));
+    boundingBox.setBottomRight(toCustom({ pos.x + bboxSize.x, pos.y + bboxSize.y }));
+}
+
+void Enemy::steerTo(float tileSize, int col, int row) {
+    // Head for the centre of the given cell.
+    float centreX = (boundingBox.getTopLeft().x + boundingBox.getBottomRight().x) * 0.5f;
+    float centreY = (boundingBox.getTopLeft().y + boundingBox.getBottomRight().y) * 0.5f;
+    float dx = (col + 0.5f) * tileSize - centreX;
+    float dy = (row + 0.5f) * tileSize - centreY;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length < 1.f)
+        velocity->setVelocity(0.f, 0.f);
+    else
+        velocity->setVelocity(dx / length, dy / length);
+}
+
+void Enemy::update(Game* game, float elapsed) {
+    float tileSize = game->spriteWH * game->tileScale;
+    float centreX = (boundingBox.getTopLeft().x + boundingBox.getBottomRight().x) * 0.5f;
+    float centreY = (boundingBox.getTopLeft().y + boundingBox.getBottomRight().y) * 0.5f;
+    int col = static_cast<int>(std::floor(centreX / tileSize));
+    int row = static_cast<int>(std::floor(centreY / tileSize));
+
+    const FlowField& field = game->getFlowField();
+    sf::Vector2i step = field.getStep(col, row);
+    if (step.x != 0 || step.y != 0) {
+        // The player is reachable: drop any wander path and chase.
+        path.clear();
+        pathRequest = 0;
+        steerTo(tileSize, col + step.x, row + step.y);
+    }
+    else if (field.getDistance(col, row) == 0) {
+        velocity->setVelocity(0.f, 0.f);
+    }
+    else {
+        wander(game, col, row, elapsed);
+    }
+
+    velocity->update(*getPositionComp(), elapsed);
+    Entity::update(game, elapsed);
+}
+
+void Enemy::wander(Game* game, int col, int row, float elapsed) {
+    PathPlanner& planner = game->getPathPlanner();
+    float tileSize = game->spriteWH * game->tileScale;
+
+    if (pathRequest != 0) {
+        PathPlanner::Status status = planner.takeResult(pathRequest, path);
+        if (status == PathPlanner::Status::Pending) {
+            velocity->setVelocity(0.f, 0.f);
+            return;
+        }
+        pathRequest = 0;
+        pathIndex = 0;
+        if (status != PathPlanner::Status::Found) path.clear();
+    }
+
+    while (pathIndex < path.size() && path[pathIndex] == sf::Vector2i(col, row))
+        pathIndex++;
+    if (pathIndex < path.size()) {
+        steerTo(tileSize, path[pathIndex].x, path[pathIndex].y);
+        return;
+    }
+
+    velocity->setVelocity(0.f, 0.f);
+    wanderDelay -= elapsed;
+    if (wanderDelay > 0.f) return;
+    wanderDelay = wanderPause;
+
+    // A small LCG seeded by the entity ID keeps wandering reproducible between runs.
+    if (wanderSeed == 0) wanderSeed = getID() * 2654435761u + 1;
+    auto next = [this](int range) {
+        wanderSeed = wanderSeed * 1664525u + 1013904223u;
+        return static_cast<int>((wanderSeed >> 8) % (2 * range + 1)) - range;
+    };
+    int dx = next(wanderRange), dy = next(wanderRange);
+    path.clear();
+    pathRequest = planner.request(sf::Vector2i(col, row), sf::Vector2i(col + dx, row + dy));
+}
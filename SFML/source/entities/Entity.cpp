@@ -7,6 +7,7 @@
 #include <iostream>
 #include "../../include/utils/Bitmask.h"
 #include "../../include/Components/TTLComponent.h"
+#include "../../include/core/ServiceLocator.h"
 
 
 // Helper function to convert sf::Vector2f to your custom Vector2f type.
@@ -15,70 +16,81 @@ inline Vector2f toCustom(const sf::Vector2f& sfv) {
 }
 
 Entity::Entity()
-    : type(EntityType::UNDEFINED), id(0), isSpriteSheet(false), deleted(false)
+    : type(EntityType::UNDEFINED), id(0), render(RenderStore::InvalidHandle), deleted(false)
 {
     // Initialize the position component.
-    positionComp = std::make_shared<PositionComponent>();
+    positionComp = makeTracked<PositionComponent>(MemoryTag::Components);
 }
 
 Entity::Entity(EntityType et)
-    : type(et), id(0), isSpriteSheet(false), deleted(false)
+    : type(et), id(0), render(RenderStore::InvalidHandle), deleted(false)
 {
-    positionComp = std::make_shared<PositionComponent>();
+    positionComp = makeTracked<PositionComponent>(MemoryTag::Components);
 }
 
-Entity::~Entity() {}
+Entity::~Entity() {
+    releaseRender();
+}
+
+void Entity::releaseRender() {
+    if (render == RenderStore::InvalidHandle) return;
+    if (auto store = ServiceLocator::getRenderStore())
+        store->release(render);
+    render = RenderStore::InvalidHandle;
+}
 
 void Entity::init(const std::string& textureFile, float scale) {
-    texture.loadFromFile(textureFile);
-    sprite.setTexture(texture);
-    sprite.setScale(scale, scale);
+    releaseRender();
+    auto store = ServiceLocator::getRenderStore();
+    render = store->addTexture(ServiceLocator::getTextures()->get(textureFile), scale);
     // Calculate bounding box size based on texture size and sprite scale.
-    bboxSize.x = texture.getSize().x * sprite.getScale().x;
-    bboxSize.y = texture.getSize().y * sprite.getScale().y;
+    bboxSize = store->getSize(render);
 }
 
 void Entity::initSpriteSheet(const std::string& spriteSheetFile) {
-    spriteSheet.loadSheet(spriteSheetFile);
-    isSpriteSheet = true;
-    spriteSheet.setAnimation("Idle", true, true);
-    bboxSize.x = spriteSheet.getSpriteSize().x * spriteSheet.getSpriteScale().x;
-    bboxSize.y = spriteSheet.getSpriteSize().y * spriteSheet.getSpriteScale().y;
+    releaseRender();
+    auto store = ServiceLocator::getRenderStore();
+    render = store->addSpriteSheet(spriteSheetFile);
+    bboxSize = store->getSize(render);
+}
+
+void Entity::reloadSpriteSheet(const SpriteSheetDef* oldDef, std::shared_ptr<const SpriteSheetDef> newDef) {
+    SpriteSheet* sheet = getRenderSheet();
+    if (!sheet || sheet->getDefinition() != oldDef) return;
+    sheet->rebind(newDef);
+    bboxSize = ServiceLocator::getRenderStore()->getSize(render);
 }
 
-void Entity::update(Game* /*game*/, float elapsed) {
+SpriteSheet* Entity::getRenderSheet() {
+    if (render == RenderStore::InvalidHandle) return nullptr;
+    return ServiceLocator::getRenderStore()->getSpriteSheet(render);
+}
+
+const SpriteSheet* Entity::getSpriteSheet() const {
+    if (render == RenderStore::InvalidHandle) return nullptr;
+    return ServiceLocator::getRenderStore()->getSpriteSheet(render);
+}
+
+void Entity::update(Game* /*game*/, float /*elapsed*/) {
     // Retrieve the position from the PositionComponent.
     sf::Vector2f pos = positionComp->getPosition();
 
-    if (isSpriteSheet) {
-        spriteSheet.getSprite().setPosition(pos.x, pos.y);
-        spriteSheet.update(elapsed);
-    }
-    else {
-        sprite.setPosition(pos.x, pos.y);
-    }
-
-    // Update the bounding box to reflect the new position.
+    // Update the bounding box to reflect the new position. Sprites are
+    // positioned when drawn, so off-screen entities never touch render data.
     boundingBox.setTopLeft(toCustom(pos));
     sf::Vector2f bottomRightPos = { pos.x + bboxSize.x, pos.y + bboxSize.y };
     boundingBox.setBottomRight(toCustom(bottomRightPos));
 }
 
-void Entity::draw(Window* window) {
-    if (isSpriteSheet)
-        window->draw(spriteSheet.getSprite());
-    else
-        window->draw(sprite);
-    window->draw(boundingBox.getDrawableRect());
+void Entity::draw(RenderCommandList& commands) const {
+    if (render != RenderStore::InvalidHandle)
+        ServiceLocator::getRenderStore()->draw(render, positionComp->getPosition(), commands);
+    commands.rect(boundingBox);
 }
 
 void Entity::setPosition(float x, float y) {
     // Update the position through the PositionComponent.
     positionComp->setPosition(x, y);
-    if (isSpriteSheet)
-        spriteSheet.getSprite().setPosition(x, y);
-    else
-        sprite.setPosition(x, y);
 }
 
 sf::Vector2f Entity::getPosition() const {
@@ -86,13 +98,13 @@ sf::Vector2f Entity::getPosition() const {
 }
 
 sf::Vector2i Entity::getTextureSize() const {
-    if (isSpriteSheet)
-        return spriteSheet.getSpriteSize();
-    return sf::Vector2i(texture.getSize().x, texture.getSize().y);
+    if (render == RenderStore::InvalidHandle)
+        return sf::Vector2i(0, 0);
+    return ServiceLocator::getRenderStore()->getTextureSize(render);
 }
 
 sf::Vector2f Entity::getSpriteScale() const {
-    if (isSpriteSheet)
-        return spriteSheet.getSpriteScale();
-    return sprite.getScale();
+    if (render == RenderStore::InvalidHandle)
+        return sf::Vector2f(1.f, 1.f);
+    return ServiceLocator::getRenderStore()->getScale(render);
 }
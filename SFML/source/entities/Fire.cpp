@@ -4,13 +4,13 @@
 #include "../../include/core/Game.h"
 #include <iostream>
 
-Fire::Fire() : Entity(EntityType::FIRE) {
+Fire::Fire() : Entity(EntityType::FIRE), poolSlot(-1), trail(ParticleSystem::InvalidEmitter) {
     // Initialize the TTL component using the defined startTimeToLive.
-    ttl = std::make_shared<TTLComponent>(startTimeToLive);
+    ttl = makeTracked<TTLComponent>(MemoryTag::Components, startTimeToLive);
     addComponent(ttl);
 
     // Initialize the Velocity component for Fire with a speed of 200.f.
-    velocity = std::make_shared<VelocityComponent>(200.f);
+    velocity = makeTracked<VelocityComponent>(MemoryTag::Components, 200.f);
     addComponent(velocity);
 
 }
@@ -22,6 +22,15 @@ std::shared_ptr<TTLComponent> Fire::getTTLComponent() const {
     return ttl;
 }
 
+void Fire::respawn(const sf::Vector2f& position, const sf::Vector2f& vel) {
+    deleted = false;
+    ttl->setTimer(InvalidTimer);
+    velocity->setVelocity(vel.x, vel.y);
+    setPosition(position.x, position.y);
+    // Refresh the bounding box before the game indexes it.
+    Entity::update(nullptr, 0.f);
+}
+
 void Fire::update(Game* game, float elapsed) {
     
     if (velocity) {
@@ -0,0 +1,38 @@
+#include "../../include/entities/FirePool.h"
+#include "../../include/core/ServiceLocator.h"
+
+void FirePool::grow() {
+    auto fire = makeTracked<Fire>(MemoryTag::Entities);
+    fire->init(Fire::textureFile, 1.f);
+    fire->setPoolSlot(static_cast<int>(fires.size()));
+    freeSlots.push_back(static_cast<int>(fires.size()));
+    fires.push_back(fire);
+}
+
+void FirePool::reserve(size_t count) {
+    fires.reserve(count);
+    freeSlots.reserve(count);
+    while (fires.size() < count)
+        grow();
+}
+
+std::shared_ptr<Fire> FirePool::acquire(const sf::Vector2f& position, const sf::Vector2f& velocity) {
+    if (freeSlots.empty())
+        grow();
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
+    const std::shared_ptr<Fire>& fire = fires[slot];
+    fire->respawn(position, velocity);
+    return fire;
+}
+
+void FirePool::release(Fire* fire) {
+    int slot = fire->getPoolSlot();
+    if (slot < 0 || slot >= static_cast<int>(fires.size()) || fires[slot].get() != fire) return;
+    // Its trail would otherwise follow the fire into its next life.
+    if (fire->getTrail() != ParticleSystem::InvalidEmitter) {
+        ServiceLocator::getParticles()->detach(fire->getTrail(), fire);
+        fire->setTrail(ParticleSystem::InvalidEmitter);
+    }
+    freeSlots.push_back(slot);
+}
@@ -1,5 +1,4 @@
 ﻿#include "../../include/entities/Player.h"
-#include "../../include/graphics/AnimBase.h"
 #include "../../include/entities/Fire.h"
 #include "../../include/core/Game.h"
 #include <iostream>
@@ -7,6 +6,7 @@
 #include "../../include/components/InputComponent.h"
 #include "../../include/core/ServiceLocator.h"
 #include "../../include/entities/StaticEntities.h"
+#include "../../include/core/GameEvents.h"
 
 const float Player::playerSpeed = 1.f;        
 const float Player::fireSpeed = 1.f;            
@@ -19,17 +19,22 @@ Player::Player()
     attacking(false),
     shouting(false),
     wood(0),
-    shootCooldown(0)
+    shootReady(true),
+    spriteSheet(nullptr),
+    idleAnim(SpriteSheet::NoAnimation),
+    walkAnim(SpriteSheet::NoAnimation),
+    attackAnim(SpriteSheet::NoAnimation),
+    shoutAnim(SpriteSheet::NoAnimation)
 {
     // Initialize player's velocity component with playerSpeed.
-    velocity = std::make_shared<VelocityComponent>(playerSpeed);
+    velocity = makeTracked<VelocityComponent>(MemoryTag::Components, playerSpeed);
     addComponent(velocity);
 
-    input = std::make_shared<PlayerInputComponent>();
+    input = makeTracked<PlayerInputComponent>(MemoryTag::Components);
     addComponent(input);
 
     // Create the HealthComponent using startingHealth and maxHealth.
-    healthComp = std::make_shared<HealthComponent>(startingHealth, maxHealth);
+    healthComp = makeTracked<HealthComponent>(MemoryTag::Components, startingHealth, maxHealth);
     addComponent(healthComp);
 }
 
@@ -41,14 +46,21 @@ void Player::init(const std::string& textureFile, float scale) {
 
 void Player::initSpriteSheet(const std::string& spriteSheetFile) {
     Entity::initSpriteSheet(spriteSheetFile);
+    spriteSheet = getRenderSheet();
+    resolveAnimations();
 }
 
-void Player::setObserver(std::shared_ptr<Observer> obs) {
-    observer = obs;
+void Player::reloadSpriteSheet(const SpriteSheetDef* oldDef, std::shared_ptr<const SpriteSheetDef> newDef) {
+    Entity::reloadSpriteSheet(oldDef, newDef);
+    // IDs may have moved if animations were added or reordered.
+    resolveAnimations();
 }
 
-std::shared_ptr<Observer> Player::getObserver() const {
-    return observer;
+void Player::resolveAnimations() {
+    idleAnim = spriteSheet->getAnimationID("Idle");
+    walkAnim = spriteSheet->getAnimationID("Walk");
+    attackAnim = spriteSheet->getAnimationID("Attack");
+    shoutAnim = spriteSheet->getAnimationID("Shout");
 }
 
 void Player::update(Game* game, float elapsed) {
@@ -61,72 +73,72 @@ void Player::update(Game* game, float elapsed) {
     sf::Vector2f vel = velocity->getVelocity();
     if (attacking ) {
         // Play the "Attack" animation
-            spriteSheet.setAnimation("Attack", true, false);
+            spriteSheet->setAnimation(attackAnim, true, false);
     }
     else if (shouting) {
         // Play the "Shout" animation
-        spriteSheet.setAnimation("Shout", true, false);
+        spriteSheet->setAnimation(shoutAnim, true, false);
     }
     else {
         if (vel.x > 0) {
-            spriteSheet.setAnimation("Walk", true, true);
-            spriteSheet.setSpriteDirection(Direction::Right);
+            spriteSheet->setAnimation(walkAnim, true, true);
+            spriteSheet->setSpriteDirection(Direction::Right);
         }
         else if (vel.x < 0) {
-            spriteSheet.setAnimation("Walk", true, true);
-            spriteSheet.setSpriteDirection(Direction::Left);
+            spriteSheet->setAnimation(walkAnim, true, true);
+            spriteSheet->setSpriteDirection(Direction::Left);
         }
         else if (vel.y < 0) {
-            spriteSheet.setAnimation("Walk", true, true);
+            spriteSheet->setAnimation(walkAnim, true, true);
         }
         else if (vel.y > 0) {
-            spriteSheet.setAnimation("Walk", true, true);
+            spriteSheet->setAnimation(walkAnim, true, true);
         }
         else {
-            spriteSheet.setAnimation("Idle", true, true);
+            spriteSheet->setAnimation(idleAnim, true, true);
         }
     }
 
-    // Decrement shoot cooldown.
-    if (shootCooldown > 0) {
-        shootCooldown -= elapsed;
-    }
     // Fire spawning: if the player is shouting, the current animation is "in action", enough wood is available,
     // and the cooldown has elapsed.
     if (shouting &&
-        spriteSheet.getCurrentAnim() && spriteSheet.getCurrentAnim()->isInAction() &&
-        wood >= static_cast<int>(shootingCost) && shootCooldown <= 0) {
-        auto fire = createFire();
-        game->addEntity(fire);
-        ServiceLocator::getAudio()->playSound("fire");
+        spriteSheet->isInAction() &&
+        wood >= static_cast<int>(shootingCost) && shootReady) {
+        auto fire = createFire(*game);
+        auto particles = ServiceLocator::getParticles();
+        fire->setTrail(particles->attach(fire, ParticleEffects::fireTrail()));
+        particles->burst(fire->getPosition(), 200, ParticleEffects::shout());
         wood -= static_cast<int>(shootingCost);
-        shootCooldown = shootCooldownTime;
+        shootReady = false;
+        game->scheduleTimer(shootCooldownTime, shared_from_this(), EntityTimer::SHOOT_COOLDOWN);
         // Reset the shouting flag so that fire is spawned only once per key press.
         shouting = false;
 
-        if (observer) {
-            observer->onShoutPerformed();
-        }
+        ServiceLocator::getEvents()->publish(ShoutPerformed{ fire->getPosition() });
     }
 
     // Reset attack/shout flags when the animation is finished.
-    if (spriteSheet.getCurrentAnim() && !spriteSheet.getCurrentAnim()->isPlaying()) {
+    if (spriteSheet->getCurrentAnim() != SpriteSheet::NoAnimation && !spriteSheet->isPlaying()) {
         attacking = false;
         shouting = false;
     }
 
     if (attacking &&
-        spriteSheet.getCurrentAnim() &&
-        spriteSheet.getCurrentAnim()->isInAction()) {
-        ServiceLocator::getAudio()->playSound("axe");
+        spriteSheet->isInAction()) {
+        ServiceLocator::getAudio()->playSound(SoundIDs::axe);
     }
 
     // Call the base Entity update to update bounding box and sprite position.
     Entity::update(game, elapsed);
 }
 
-void Player::draw(Window* window) {
-    Entity::draw(window);
+void Player::onTimer(EntityTimer event) {
+    if (event == EntityTimer::SHOOT_COOLDOWN)
+        shootReady = true;
+}
+
+void Player::draw(RenderCommandList& commands) const {
+    Entity::draw(commands);
 }
 
 void Player::handleInput(Game& game) {
@@ -141,22 +153,13 @@ void Player::addWood(int w) {
     if (wood < 0) { wood = 0; }
 }
 
-std::shared_ptr<Fire> Player::createFire() const {
-    auto fireEntity = std::make_shared<Fire>();
+std::shared_ptr<Fire> Player::createFire(Game& game) const {
     sf::Vector2f pos = getPosition();
     pos.x += getTextureSize().x * 0.5f;
     pos.y += getTextureSize().y * 0.5f;
-    fireEntity->init("img/fire.png", 1.f);
-    fireEntity->setPosition(pos.x, pos.y);
     // Set fire velocity based on player's facing direction.
-    auto fireVel = fireEntity->getVelocityComp();
-    if (fireVel) {
-        if (spriteSheet.getSpriteDirection() == Direction::Left)
-            fireVel->setVelocity(-fireSpeed, 0.f);
-        else
-            fireVel->setVelocity(fireSpeed, 0.f);
-    }
-    return fireEntity;
+    sf::Vector2f vel(spriteSheet->getSpriteDirection() == Direction::Left ? -fireSpeed : fireSpeed, 0.f);
+    return game.spawnFire(pos, vel);
 }
 
 void Player::positionSprite(int row, int col, int spriteWH, float tileScale) {
@@ -180,14 +183,14 @@ void Player::handlePotionCollision(Entity* potion) {
         healthComp->changeHealth(potionHealth);
         std::cout << "Potion restores: " << potionHealth
             << ", Player Health: " << healthComp->getHealth() << std::endl;
-        if (observer) observer->onPotionCollected();
-        ServiceLocator::getAudio()->playSound("pickup");
+        ServiceLocator::getEvents()->publish(PotionCollected{ potionHealth, potion->getPosition() });
+        ServiceLocator::getParticles()->burst(potion->getPosition(), 60, ParticleEffects::pickup());
         potion->deleteEntity();
     }
 }
 
 void Player::handleLogCollision(Entity* log) {
-    if (!isAttacking() || !spriteSheet.getCurrentAnim() || !spriteSheet.getCurrentAnim()->isInAction())
+    if (!isAttacking() || !spriteSheet->isInAction())
         return;
 
     auto logObj = dynamic_cast<Log*>(log);
@@ -196,6 +199,8 @@ void Player::handleLogCollision(Entity* log) {
         addWood(logWood);
         std::cout << "Wood collected: " << logWood
             << ", Total Wood: " << getWood() << std::endl;
+        ServiceLocator::getEvents()->publish(WoodCollected{ logWood, getWood() });
+        ServiceLocator::getParticles()->burst(log->getPosition(), 40, ParticleEffects::woodChips());
         log->deleteEntity();
     }
 }
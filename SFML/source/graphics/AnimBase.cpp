@@ -1,72 +1,26 @@
 #include "../../include/graphics/AnimBase.h"
-#include "../../include/graphics/SpriteSheet.h"
+#include <cstdlib>
 
 AnimBase::AnimBase() : 
-	curFrame(0),
 	startFrame(0),
 	endFrame(0),
 	frameRow(0),
-	frameTime(1.f),
-	elapsedTime(0.f),
 	frameActionStart(-1),
 	frameActionEnd(-1),
-	loop(false),
-	playing(false),
-	spriteSheet(nullptr)
+	frameTime(1.f)
 {}
 
 AnimBase::~AnimBase() {}
 
-void AnimBase::setFrame(int fr)
+int AnimBase::getFrameCount() const
 {
-	if ((fr >= startFrame && fr <= endFrame) || (fr >= endFrame && fr <= startFrame))
-		curFrame = fr;
+	return std::abs(endFrame - startFrame) + 1;
 }
 
-bool AnimBase::isInAction()
+int AnimBase::toPlayIndex(int column) const
 {
-	if (frameActionStart == -1 || frameActionEnd == -1)
-		return true;
-
-	return (curFrame >= frameActionStart && curFrame <= frameActionEnd);
-}
-
-void AnimBase::play()
-{
-	playing = true;
+	int index = (startFrame <= endFrame) ? column - startFrame : startFrame - column;
+	if (index < 0 || index >= getFrameCount())
+		return -1;
+	return index;
 }
-
-void AnimBase::pause()
-{
-	playing = false;
-}
-
-void AnimBase::stop()
-{
-	playing = false;
-	reset();
-}
-
-void AnimBase::reset()
-{
-	curFrame = startFrame;
-	elapsedTime = 0.0f;
-	cropSprite();
-}
-
-void AnimBase::update(float eTime)
-{
-	if (!playing)
-		return;
-
-	elapsedTime += eTime;
-
-	if (elapsedTime < frameTime)
-		return;
-
-	frameStep();
-	cropSprite();
-	elapsedTime = 0;
-}
-
-
@@ -1,37 +1,20 @@
 #include "../../include/graphics/AnimDirectional.h"
-#include "../../include/graphics/SpriteSheet.h"
 
-void AnimDirectional::frameStep()
+void AnimDirectional::buildFrames(const sf::Vector2i& spriteSize, size_t numAnimations, std::vector<sf::IntRect>& out) const
 {
-	//Advance to the next frame in the sheet.
-	if (startFrame < endFrame)	curFrame++;
-	else						curFrame--; //Backwards animations
+	//Backwards animations step down through the columns.
+	const int step = (startFrame <= endFrame) ? 1 : -1;
+	const int count = getFrameCount();
 
-	//We reached the end.
-	if ((startFrame < endFrame && curFrame > endFrame) || (startFrame > endFrame && curFrame < endFrame))
+	for (int dir = 0; dir < numDirections; dir++)
 	{
-		if (loop)
+		int y = spriteSize.y * (frameRow + static_cast<int>(numAnimations) * dir);
+		for (int i = 0; i < count; i++)
 		{
-			//If looping, back to start.
-			curFrame = startFrame;
-			return;
+			int x = spriteSize.x * (startFrame + i * step);
+			out.emplace_back(x, y, spriteSize.x, spriteSize.y);
 		}
-
-		//Get to the end of the animation and pause the play.
-		curFrame = endFrame;
-		pause();
 	}
-
-}
-
-void AnimDirectional::cropSprite()
-{
-	const auto spriteSize = spriteSheet->getSpriteSize();
-	size_t numAnimations = spriteSheet->getNumAnimations();
-	size_t x = spriteSize.x * curFrame;
-	size_t y = spriteSize.y * (frameRow + numAnimations * static_cast<short>(spriteSheet->getSpriteDirection()));
-	sf::IntRect rect(static_cast<int>(x), static_cast<int>(y), spriteSize.x, spriteSize.y);
-	spriteSheet->cropSprite(rect);
 }
 
 void AnimDirectional::readIn(std::stringstream& st)
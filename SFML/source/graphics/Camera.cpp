@@ -0,0 +1,34 @@
+#include "../../include/graphics/Camera.h"
+
+Camera::Camera() : viewSize(0.f, 0.f), worldSize(0.f, 0.f) {}
+
+void Camera::setViewSize(const sf::Vector2f& size) {
+    viewSize = size;
+    view.setSize(size);
+}
+
+void Camera::setWorldSize(const sf::Vector2f& size) {
+    worldSize = size;
+}
+
+void Camera::follow(const sf::Vector2f& target) {
+    view.setCenter(clampAxis(target.x, viewSize.x, worldSize.x),
+                   clampAxis(target.y, viewSize.y, worldSize.y));
+}
+
+Rectangle Camera::getViewRect() const {
+    const sf::Vector2f& center = view.getCenter();
+    Vector2f half(viewSize.x * 0.5f, viewSize.y * 0.5f);
+    return Rectangle(Vector2f(center.x, center.y) - half, Vector2f(center.x, center.y) + half);
+}
+
+float Camera::clampAxis(float target, float viewExtent, float worldExtent) const {
+    // World smaller than the view: keep it centered.
+    if (worldExtent <= viewExtent)
+        return worldExtent * 0.5f;
+
+    float half = viewExtent * 0.5f;
+    if (target < half) return half;
+    if (target > worldExtent - half) return worldExtent - half;
+    return target;
+}
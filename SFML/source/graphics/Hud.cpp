@@ -0,0 +1,137 @@
+#include "../../include/graphics/Hud.h"
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+namespace {
+    const sf::Time readoutInterval = sf::milliseconds(250);
+}
+
+HudWidget::HudWidget()
+    : lastValue(0), lastMax(0), built(false), visible(true)
+{
+    buffer[0] = '\0';
+}
+
+void HudWidget::setup(const sf::Font& font, unsigned int size, const sf::Color& color, const std::string& lbl)
+{
+    text.setFont(font);
+    text.setCharacterSize(size);
+    text.setFillColor(color);
+    label = lbl.substr(0, sizeof(buffer) / 2);
+    text.setString(label);
+    built = false;
+}
+
+bool HudWidget::setValue(int value, int maxValue)
+{
+    if (built && value == lastValue && maxValue == lastMax)
+        return false;
+
+    lastValue = value;
+    lastMax = maxValue;
+    built = true;
+
+    // Format "<label><value>[/<max>]" in place, without heap allocations.
+    char* end = buffer + sizeof(buffer) - 1;
+    char* p = std::copy(label.begin(), label.end(), buffer);
+    p = std::to_chars(p, end, value).ptr;
+    if (maxValue >= 0 && p < end) {
+        *p++ = '/';
+        p = std::to_chars(p, end, maxValue).ptr;
+    }
+    *p = '\0';
+    text.setString(buffer);
+    return true;
+}
+
+bool HudWidget::setVisible(bool v)
+{
+    if (visible == v)
+        return false;
+    visible = v;
+    return true;
+}
+
+void HudWidget::draw(sf::RenderTarget& target) const
+{
+    if (visible)
+        target.draw(text);
+}
+
+Hud::Hud() : ready(false), dirty(true), readoutsDue(true) {}
+
+void Hud::init(const sf::Font& font, unsigned int fontSize)
+{
+    fpsWidget.setup(font, fontSize, sf::Color::Red, "FPS: ");
+    fpsWidget.setPosition(10.f, 0.f);
+
+    healthWidget.setup(font, fontSize, sf::Color::Green, "Health: ");
+    healthWidget.setPosition(10.f, 60.f);
+    healthWidget.setVisible(false);
+
+    woodWidget.setup(font, fontSize, sf::Color::Yellow, "Wood: ");
+    woodWidget.setPosition(10.f, 120.f);
+    woodWidget.setVisible(false);
+
+    memoryWidget.setup(font, fontSize, sf::Color::White, "Memory (KiB): ");
+    memoryWidget.setPosition(10.f, 180.f);
+
+    pausedWidget.setup(font, fontSize + 10, sf::Color::Blue, "PAUSED!");
+    pausedWidget.setVisible(false);
+
+    dirty = true;
+    readoutsDue = true;
+}
+
+void Hud::resize(const sf::Vector2u& size)
+{
+    if (size.x == 0 || size.y == 0)
+        return;
+    if (!cache.create(size.x, size.y))
+        throw std::runtime_error("Hud: failed to create render texture");
+    cacheSprite.setTexture(cache.getTexture(), true);
+    pausedWidget.setPosition(size.x * 0.5f, 0.0f);
+    ready = true;
+    dirty = true;
+}
+
+void Hud::update(const HudState& state)
+{
+    if (readoutsDue || readoutClock.getElapsedTime() >= readoutInterval) {
+        readoutClock.restart();
+        readoutsDue = false;
+        dirty |= fpsWidget.setValue(state.fps);
+        dirty |= memoryWidget.setValue(state.memoryKiB, state.memoryBudgetKiB);
+    }
+
+    dirty |= healthWidget.setVisible(state.hasPlayer);
+    dirty |= woodWidget.setVisible(state.hasPlayer);
+    if (state.hasPlayer) {
+        dirty |= healthWidget.setValue(state.health, state.maxHealth);
+        dirty |= woodWidget.setValue(state.wood);
+    }
+
+    dirty |= pausedWidget.setVisible(state.paused);
+}
+
+void Hud::compose()
+{
+    cache.clear(sf::Color::Transparent);
+    fpsWidget.draw(cache);
+    healthWidget.draw(cache);
+    woodWidget.draw(cache);
+    memoryWidget.draw(cache);
+    pausedWidget.draw(cache);
+    cache.display();
+    dirty = false;
+}
+
+void Hud::draw(sf::RenderTarget& target)
+{
+    if (!ready)
+        return;
+    if (dirty)
+        compose();
+    target.draw(cacheSprite);
+}
@@ -0,0 +1,126 @@
+#include "../../include/graphics/RecordingRenderBackend.h"
+#include "../../include/utils/MemoryTracker.h"
+#include <stdexcept>
+
+namespace {
+    void writeMemory(std::ostream& out, bool peak) {
+        for (size_t i = 0; i < MemoryTracker::tagCount; i++) {
+            MemoryStats stats = MemoryTracker::get(static_cast<MemoryTag>(i));
+            out << ',' << MemoryTracker::toKiB(peak ? stats.peak : stats.current);
+        }
+    }
+}
+
+RecordingRenderBackend::RecordingRenderBackend(const std::string& file)
+    : out(file, std::ios::trunc), frameCount(0), batchTexture(nullptr), batchVertices(0)
+{
+    if (!out.is_open())
+        throw std::runtime_error("RecordingRenderBackend: cannot open " + file);
+    out << "frame,commands,draw_calls,vertices,texture_changes,view_changes,quads,rects";
+    for (size_t i = 0; i < MemoryTracker::tagCount; i++)
+        out << ",mem_" << MemoryTracker::getName(static_cast<MemoryTag>(i)) << "_kib";
+    out << '\n';
+}
+
+RecordingRenderBackend::~RecordingRenderBackend()
+{
+    if (frameCount == 0)
+        return;
+    out << "# total," << totals.commands << ',' << totals.drawCalls << ',' << totals.vertices << ','
+        << totals.textureChanges << ',' << totals.viewChanges << ',' << totals.quads << ',' << totals.rects;
+    writeMemory(out, true);
+    out << '\n';
+}
+
+void RecordingRenderBackend::beginFrame()
+{
+    current = FrameStats();
+    batchTexture = nullptr;
+    batchVertices = 0;
+}
+
+void RecordingRenderBackend::flush()
+{
+    if (batchVertices == 0)
+        return;
+    current.drawCalls++;
+    current.vertices += batchVertices;
+    batchVertices = 0;
+}
+
+void RecordingRenderBackend::submit(const RenderCommandList& commands)
+{
+    for (const auto& cmd : commands.getCommands()) {
+        current.commands++;
+        switch (cmd.type) {
+        case RenderCommandType::View:
+            flush();
+            current.viewChanges++;
+            break;
+        case RenderCommandType::Quad:
+            if (batchVertices > 0 && cmd.texture != batchTexture) {
+                flush();
+                current.textureChanges++;
+            }
+            batchTexture = cmd.texture;
+            batchVertices += 6;
+            current.quads++;
+            break;
+        case RenderCommandType::Rect:
+            // Outlines are four untextured quads.
+            if (batchVertices > 0 && batchTexture != nullptr) {
+                flush();
+                current.textureChanges++;
+            }
+            batchTexture = nullptr;
+            batchVertices += 24;
+            current.rects++;
+            break;
+        case RenderCommandType::Vertices:
+            // Drawn directly, outside the quad batch.
+            flush();
+            current.drawCalls++;
+            current.vertices += cmd.vertexCount;
+            current.textureChanges++;
+            break;
+        case RenderCommandType::Hud:
+            // The cached HUD layer is a single textured sprite.
+            flush();
+            current.drawCalls++;
+            current.vertices += 4;
+            current.textureChanges++;
+            break;
+        }
+    }
+    flush();
+}
+
+void RecordingRenderBackend::endFrame()
+{
+    writeFrame(frameCount);
+}
+
+void RecordingRenderBackend::record(unsigned long frame, const RenderCommandList& commands)
+{
+    beginFrame();
+    submit(commands);
+    writeFrame(frame);
+}
+
+void RecordingRenderBackend::writeFrame(unsigned long frame)
+{
+    out << frame << ',' << current.commands << ',' << current.drawCalls << ',' << current.vertices << ','
+        << current.textureChanges << ',' << current.viewChanges << ',' << current.quads << ',' << current.rects;
+    writeMemory(out, false);
+    out << '\n';
+
+    totals.commands += current.commands;
+    totals.drawCalls += current.drawCalls;
+    totals.vertices += current.vertices;
+    totals.textureChanges += current.textureChanges;
+    totals.viewChanges += current.viewChanges;
+    totals.quads += current.quads;
+    totals.rects += current.rects;
+    last = current;
+    frameCount++;
+}
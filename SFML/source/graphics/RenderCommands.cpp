@@ -0,0 +1,85 @@
+#include "../../include/graphics/RenderCommands.h"
+
+void RenderCommandList::clear() {
+    commands.clear();
+    views.clear();
+    vertices.clear();
+}
+
+RenderCommand& RenderCommandList::push(RenderCommandType type) {
+    commands.emplace_back();
+    RenderCommand& cmd = commands.back();
+    cmd.type = type;
+    cmd.texture = nullptr;
+    cmd.thickness = 0.f;
+    cmd.viewIndex = -1;
+    cmd.firstVertex = 0;
+    cmd.vertexCount = 0;
+    return cmd;
+}
+
+void RenderCommandList::setView(const sf::View& view) {
+    push(RenderCommandType::View).viewIndex = static_cast<int>(views.size());
+    views.push_back(view);
+}
+
+void RenderCommandList::setScreenView() {
+    push(RenderCommandType::View);
+}
+
+void RenderCommandList::quad(const CachedTexture* texture, const sf::IntRect& textureRect,
+                             const sf::Vector2f& position, const sf::Vector2f& scale) {
+    RenderCommand& cmd = push(RenderCommandType::Quad);
+    cmd.texture = texture;
+    cmd.textureRect = textureRect;
+    cmd.position = position;
+    cmd.scale = scale;
+}
+
+void RenderCommandList::rect(const sf::FloatRect& bounds, const sf::Color& color, float thickness) {
+    RenderCommand& cmd = push(RenderCommandType::Rect);
+    cmd.bounds = bounds;
+    cmd.color = color;
+    cmd.thickness = thickness;
+}
+
+void RenderCommandList::rect(const Rectangle& r) {
+    const Vector2f& tl = r.getTopLeft();
+    const Vector2f& br = r.getBottomRight();
+    rect(sf::FloatRect(tl.x, tl.y, br.x - tl.x, br.y - tl.y), sf::Color::Green, 4.f);
+}
+
+void RenderCommandList::hud(const HudState& state) {
+    push(RenderCommandType::Hud);
+    hudState = state;
+}
+
+std::vector<sf::Vertex>& RenderCommandList::beginVertices(const CachedTexture* texture) {
+    RenderCommand& cmd = push(RenderCommandType::Vertices);
+    cmd.texture = texture;
+    cmd.firstVertex = static_cast<unsigned int>(vertices.size());
+    return vertices;
+}
+
+void RenderCommandList::endVertices() {
+    RenderCommand& cmd = commands.back();
+    cmd.vertexCount = static_cast<unsigned int>(vertices.size()) - cmd.firstVertex;
+    if (cmd.vertexCount == 0)
+        commands.pop_back();
+}
+
+void RenderCommandList::append(const RenderCommandList& other) {
+    int viewOffset = static_cast<int>(views.size());
+    unsigned int vertexOffset = static_cast<unsigned int>(vertices.size());
+    views.insert(views.end(), other.views.begin(), other.views.end());
+    vertices.insert(vertices.end(), other.vertices.begin(), other.vertices.end());
+    for (const auto& cmd : other.commands) {
+        commands.push_back(cmd);
+        if (cmd.type == RenderCommandType::View && cmd.viewIndex >= 0)
+            commands.back().viewIndex += viewOffset;
+        else if (cmd.type == RenderCommandType::Vertices)
+            commands.back().firstVertex += vertexOffset;
+        else if (cmd.type == RenderCommandType::Hud)
+            hudState = other.hudState;
+    }
+}
@@ -0,0 +1,82 @@
+#include "../../include/graphics/RenderStore.h"
+#include "../../include/core/ServiceLocator.h"
+
+RenderHandle RenderStore::allocate() {
+    if (!freeSlots.empty()) {
+        RenderHandle h = freeSlots.back();
+        freeSlots.pop_back();
+        return h;
+    }
+    slots.emplace_back();
+    updateCharge();
+    return static_cast<RenderHandle>(slots.size() - 1);
+}
+
+void RenderStore::updateCharge() {
+    memory.set(slots.capacity() * sizeof(Slot) + freeSlots.capacity() * sizeof(RenderHandle) +
+               sheetCount * sizeof(SpriteSheet));
+}
+
+RenderHandle RenderStore::addTexture(std::shared_ptr<const CachedTexture> texture, float scale) {
+    RenderHandle h = allocate();
+    slots[h].texture = std::move(texture);
+    slots[h].scale = sf::Vector2f(scale, scale);
+    return h;
+}
+
+RenderHandle RenderStore::addSpriteSheet(const std::string& file) {
+    auto sheet = std::make_unique<SpriteSheet>();
+    sheet->loadSheet(file);
+    sheet->setAnimation("Idle", true, true);
+    RenderHandle h = allocate();
+    slots[h].scale = sheet->getSpriteScale();
+    slots[h].sheet = std::move(sheet);
+    sheetCount++;
+    updateCharge();
+    return h;
+}
+
+void RenderStore::release(RenderHandle h) {
+    if (h < 0 || h >= static_cast<RenderHandle>(slots.size())) return;
+    slots[h].texture.reset();
+    if (slots[h].sheet) {
+        slots[h].sheet.reset();
+        sheetCount--;
+    }
+    freeSlots.push_back(h);
+    updateCharge();
+}
+
+sf::Vector2i RenderStore::getTextureSize(RenderHandle h) const {
+    const Slot& slot = slots[h];
+    if (slot.sheet)
+        return slot.sheet->getSpriteSize();
+    if (!slot.texture)
+        return sf::Vector2i(0, 0);
+    const sf::Vector2u& size = slot.texture->getSize();
+    return sf::Vector2i(size.x, size.y);
+}
+
+sf::Vector2f RenderStore::getScale(RenderHandle h) const {
+    const Slot& slot = slots[h];
+    return slot.sheet ? slot.sheet->getSpriteScale() : slot.scale;
+}
+
+sf::Vector2f RenderStore::getSize(RenderHandle h) const {
+    sf::Vector2i size = getTextureSize(h);
+    sf::Vector2f scale = getScale(h);
+    return sf::Vector2f(size.x * scale.x, size.y * scale.y);
+}
+
+void RenderStore::draw(RenderHandle h, const sf::Vector2f& position, RenderCommandList& commands) {
+    Slot& slot = slots[h];
+    if (slot.sheet) {
+        // The frame rect is kept current by the AnimationSystem; only the position is synced here.
+        slot.sheet->setSpritePosition(position);
+        slot.sheet->draw(commands);
+    }
+    else if (slot.texture) {
+        const sf::Vector2u& size = slot.texture->getSize();
+        commands.quad(slot.texture.get(), sf::IntRect(0, 0, size.x, size.y), position, slot.scale);
+    }
+}
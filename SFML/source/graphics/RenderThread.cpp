@@ -0,0 +1,40 @@
+#include "../../include/graphics/RenderThread.h"
+
+RenderThread::RenderThread()
+    : backend(nullptr), running(false)
+{
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start() {
+    if (running || !backend) return;
+    // Release the context here so the render thread can take it.
+    backend->setActive(false);
+    running = true;
+    thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::stop() {
+    if (!running) return;
+    running = false;
+    buffer.wake();
+    if (thread.joinable())
+        thread.join();
+}
+
+void RenderThread::run() {
+    backend->setActive(true);
+    while (running) {
+        // Timeout keeps the loop responsive to stop() when the sim is paused.
+        const RenderCommandList* commands = buffer.acquire(std::chrono::milliseconds(100));
+        if (!commands)
+            continue;
+        backend->beginFrame();
+        backend->submit(*commands);
+        backend->endFrame();
+    }
+    backend->setActive(false);
+}
@@ -1,13 +1,13 @@
 #include "../../include/graphics/SpriteSheet.h"
-#include "../../include/graphics/AnimDirectional.h"
-#include <fstream>
-#include <sstream>
-#include <stdexcept>
+#include "../../include/core/ServiceLocator.h"
+
+const sf::Vector2i SpriteSheet::noSize(0, 0);
 
 SpriteSheet::SpriteSheet() :
-    curAnimation(nullptr),
     spriteScale(1.f, 1.f),
-    direction(Direction::Right)
+    direction(Direction::Right),
+    curAnimation(NoAnimation),
+    animHandle(AnimationSystem::InvalidHandle)
 {
 }
 
@@ -16,15 +16,14 @@ SpriteSheet::~SpriteSheet() {
 }
 
 void SpriteSheet::releaseSheet() {
-    curAnimation = nullptr;
-    for (auto& pair : animations) {
-        delete pair.second;
+    curAnimation = NoAnimation;
+    if (animHandle != AnimationSystem::InvalidHandle) {
+        auto animSystem = ServiceLocator::getAnimations();
+        if (animSystem)
+            animSystem->remove(animHandle);
+        animHandle = AnimationSystem::InvalidHandle;
     }
-    animations.clear();
-}
-
-void SpriteSheet::setSpriteSize(const sf::Vector2i& size) {
-    spriteSize = size;
+    def.reset();
 }
 
 void SpriteSheet::setSpriteScale(const sf::Vector2f& scale) {
@@ -40,8 +39,8 @@ void SpriteSheet::setSpriteDirection(const Direction& dir) {
     if (dir == direction)
         return;
     direction = dir;
-    if (curAnimation != nullptr)
-        curAnimation->cropSprite();
+    if (curAnimation != NoAnimation)
+        ServiceLocator::getAnimations()->setFrames(animHandle, def->getFrames(curAnimation, direction));
 }
 
 void SpriteSheet::cropSprite(const sf::IntRect& rect) {
@@ -49,81 +48,64 @@ void SpriteSheet::cropSprite(const sf::IntRect& rect) {
 }
 
 bool SpriteSheet::loadSheet(const std::string& file) {
-    std::ifstream sheet(file);
-    if (!sheet.is_open())
-        throw std::runtime_error("ERROR: failed loading spritesheet " + file);
-
     releaseSheet();
-    std::string line;
-    while (std::getline(sheet, line)) {
-        if (line.empty() || line[0] == '#')
-            continue;
-        std::stringstream keystream(line);
-        std::string type;
-        keystream >> type;
-        if (type == "Texture") {
-            std::string textureFile;
-            keystream >> textureFile;
-            if (!texture.loadFromFile(textureFile))
-                throw std::runtime_error("Texture file not found: " + textureFile);
-            sprite.setTexture(texture);
-        }
-        else if (type == "Size") {
-            keystream >> spriteSize.x >> spriteSize.y;
-            setSpriteSize(spriteSize);
-        }
-        else if (type == "Scale") {
-            keystream >> spriteScale.x >> spriteScale.y;
-            setSpriteScale(spriteScale);
-        }
-        else if (type == "AnimationType") {
-            keystream >> animType;
-        }
-        else if (type == "Animation") {
-            std::string name;
-            keystream >> name;
-            if (animations.find(name) != animations.end())
-                throw std::runtime_error("Duplicated animation: " + name + " in sprite sheet " + file);
-            AnimBase* anim = nullptr;
-            if (animType == "Directional")
-                anim = new AnimDirectional();
-            else
-                throw std::runtime_error("Unknown animation type: " + animType + " in sprite sheet " + file);
-
-            keystream >> *anim;
-            anim->setSpriteSheet(this);
-            anim->setName(name);
-            anim->reset();
-            animations.emplace(name, anim);
-        }
-    }
-    sheet.close();
+    def = ServiceLocator::getSpriteSheets()->get(file);
+    sprite.setTextureRect(sf::IntRect(0, 0, def->getSpriteSize().x, def->getSpriteSize().y));
+    setSpriteScale(def->getSpriteScale());
+    animHandle = ServiceLocator::getAnimations()->add(&sprite);
     return true;
 }
 
-AnimBase* SpriteSheet::getCurrentAnim() const {
-    return curAnimation;
+void SpriteSheet::rebind(std::shared_ptr<const SpriteSheetDef> newDef) {
+    if (!def || !newDef) return;
+    AnimID next = curAnimation == NoAnimation ? NoAnimation
+        : newDef->getAnimationID(def->getAnimationName(curAnimation));
+    def = newDef;
+    setSpriteScale(def->getSpriteScale());
+
+    curAnimation = next;
+    auto animSystem = ServiceLocator::getAnimations();
+    if (curAnimation != NoAnimation) {
+        const auto& clip = def->getClip(curAnimation);
+        animSystem->retarget(animHandle, def->getFrames(curAnimation, direction), clip.frameCount, clip.frameTime);
+    }
+    else {
+        animSystem->play(animHandle, nullptr, 0, 1.f, false, false);
+    }
+}
+
+AnimID SpriteSheet::getAnimationID(const std::string& name) const {
+    return def ? def->getAnimationID(name) : NoAnimation;
 }
 
-bool SpriteSheet::setAnimation(const std::string& name, bool play, bool loop) {
-    auto itr = animations.find(name);
-    if (itr == animations.end()) return false;
-    if (itr->second == curAnimation) return false;
-    if (curAnimation)
-        curAnimation->stop();
-    curAnimation = itr->second;
-    curAnimation->setLooping(loop);
-    if (play)
-        curAnimation->play();
-    curAnimation->cropSprite();
+bool SpriteSheet::setAnimation(AnimID id, bool play, bool loop) {
+    if (!def || id < 0 || id >= static_cast<AnimID>(def->getNumAnimations())) return false;
+    if (id == curAnimation) return false;
+    curAnimation = id;
+    const auto& clip = def->getClip(id);
+    ServiceLocator::getAnimations()->play(animHandle, def->getFrames(id, direction), clip.frameCount, clip.frameTime, loop, play);
     return true;
 }
 
-void SpriteSheet::update(float elapsedTime) {
-    if (curAnimation)
-        curAnimation->update(elapsedTime);
+bool SpriteSheet::setAnimation(const std::string& name, bool play, bool loop) {
+    return setAnimation(getAnimationID(name), play, loop);
+}
+
+bool SpriteSheet::isPlaying() const {
+    if (curAnimation == NoAnimation) return false;
+    return ServiceLocator::getAnimations()->isPlaying(animHandle);
+}
+
+bool SpriteSheet::isInAction() const {
+    if (curAnimation == NoAnimation) return false;
+    const auto& clip = def->getClip(curAnimation);
+    if (clip.actionFirst == -1)
+        return true;
+    int frame = ServiceLocator::getAnimations()->getFrame(animHandle);
+    return frame >= clip.actionFirst && frame <= clip.actionLast;
 }
 
-void SpriteSheet::draw(sf::RenderWindow* window) {
-    window->draw(sprite);
+void SpriteSheet::draw(RenderCommandList& commands) const {
+    if (def)
+        commands.quad(def->getTexture(), sprite.getTextureRect(), sprite.getPosition(), sprite.getScale());
 }
@@ -0,0 +1,32 @@
+#include "../../include/graphics/SpriteSheetCache.h"
+
+std::shared_ptr<const SpriteSheetDef> SpriteSheetCache::get(const std::string& file) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = sheets.find(file);
+    if (it != sheets.end())
+        return it->second;
+
+    auto def = SpriteSheetDef::load(file);
+    sheets[file] = def;
+    return def;
+}
+
+std::shared_ptr<const SpriteSheetDef> SpriteSheetCache::reload(const std::string& file) {
+    auto def = SpriteSheetDef::load(file, true);
+    std::lock_guard<std::mutex> lock(mtx);
+    sheets[file] = def;
+    return def;
+}
+
+bool SpriteSheetCache::contains(const std::string& file) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return sheets.count(file) > 0;
+}
+
+std::vector<std::string> SpriteSheetCache::getFiles() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<std::string> files;
+    for (const auto& entry : sheets)
+        files.push_back(entry.first);
+    return files;
+}
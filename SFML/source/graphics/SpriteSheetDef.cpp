@@ -0,0 +1,229 @@
+#include "../../include/graphics/SpriteSheetDef.h"
+#include "../../include/graphics/AnimDirectional.h"
+#include "../../include/core/ServiceLocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    const char binaryMagic[4] = { 'S', 'S', 'H', 'B' };
+    const uint32_t binaryVersion = 1;
+
+    template<typename T>
+    void writePod(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool readPod(std::istream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    void writeString(std::ostream& out, const std::string& s) {
+        writePod(out, static_cast<uint32_t>(s.size()));
+        out.write(s.data(), s.size());
+    }
+
+    bool readString(std::istream& in, std::string& s) {
+        uint32_t len = 0;
+        if (!readPod(in, len) || len > 4096) return false;
+        s.resize(len);
+        return static_cast<bool>(in.read(&s[0], len));
+    }
+
+    // Bytes left after the read position, so counts read from a file can be
+    // checked before anything is allocated for them.
+    size_t remaining(std::istream& in) {
+        std::streampos pos = in.tellg();
+        in.seekg(0, std::ios::end);
+        std::streampos end = in.tellg();
+        in.seekg(pos);
+        return pos < 0 || end < pos ? 0 : static_cast<size_t>(end - pos);
+    }
+}
+
+std::shared_ptr<const SpriteSheetDef> SpriteSheetDef::load(const std::string& file, bool forceText) {
+    namespace fs = std::filesystem;
+    auto def = std::make_shared<SpriteSheetDef>();
+    std::string cacheFile = cacheFileFor(file);
+
+    std::error_code ec;
+    bool haveText = fs::exists(file, ec);
+    bool cacheFresh = !forceText && fs::exists(cacheFile, ec) &&
+        (!haveText || fs::last_write_time(cacheFile, ec) >= fs::last_write_time(file, ec));
+
+    if (!cacheFresh || !def->readBinary(cacheFile)) {
+        def = std::make_shared<SpriteSheetDef>();
+        def->readText(file);
+        def->writeBinary(cacheFile);
+    }
+    def->finishLoad();
+    return def;
+}
+
+std::string SpriteSheetDef::cacheFileFor(const std::string& file) {
+    return std::filesystem::path(file).replace_extension(".ssb").string();
+}
+
+void SpriteSheetDef::readText(const std::string& file) {
+    std::ifstream sheet(file);
+    if (!sheet.is_open())
+        throw std::runtime_error("ERROR: failed loading spritesheet " + file);
+
+    // Definitions are only needed until their frame tables are compiled.
+    std::vector<std::unique_ptr<AnimBase>> anims;
+    std::string line;
+    while (std::getline(sheet, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::stringstream keystream(line);
+        std::string type;
+        keystream >> type;
+        if (type == "Texture") {
+            keystream >> textureFile;
+        }
+        else if (type == "Size") {
+            keystream >> spriteSize.x >> spriteSize.y;
+        }
+        else if (type == "Scale") {
+            keystream >> spriteScale.x >> spriteScale.y;
+        }
+        else if (type == "AnimationType") {
+            keystream >> animType;
+        }
+        else if (type == "Animation") {
+            std::string name;
+            keystream >> name;
+            if (std::find(names.begin(), names.end(), name) != names.end())
+                throw std::runtime_error("Duplicated animation: " + name + " in sprite sheet " + file);
+            std::unique_ptr<AnimBase> anim;
+            if (animType == "Directional")
+                anim = std::make_unique<AnimDirectional>();
+            else
+                throw std::runtime_error("Unknown animation type: " + animType + " in sprite sheet " + file);
+
+            keystream >> *anim;
+            anim->setName(name);
+            names.push_back(name);
+            anims.push_back(std::move(anim));
+        }
+    }
+
+    // Row layout depends on the total animation count, so compile after parsing.
+    for (const auto& anim : anims) {
+        AnimClip clip;
+        clip.firstRect = static_cast<int>(frameRects.size());
+        clip.frameCount = anim->getFrameCount();
+        clip.frameTime = anim->getFrameTime();
+        clip.actionFirst = -1;
+        clip.actionLast = -1;
+        if (anim->getFrameActionStart() != -1 && anim->getFrameActionEnd() != -1) {
+            int a = anim->toPlayIndex(anim->getFrameActionStart());
+            int b = anim->toPlayIndex(anim->getFrameActionEnd());
+            clip.actionFirst = std::min(a, b);
+            clip.actionLast = std::max(a, b);
+        }
+        anim->buildFrames(spriteSize, anims.size(), frameRects);
+        clips.push_back(clip);
+    }
+}
+
+bool SpriteSheetDef::readBinary(const std::string& file) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in.is_open())
+        return false;
+
+    char magic[4];
+    uint32_t version = 0;
+    if (!in.read(magic, 4) || !std::equal(magic, magic + 4, binaryMagic)) return false;
+    if (!readPod(in, version) || version != binaryVersion) return false;
+
+    if (!readString(in, textureFile) || !readString(in, animType)) return false;
+    if (!readPod(in, spriteSize.x) || !readPod(in, spriteSize.y)) return false;
+    if (!readPod(in, spriteScale.x) || !readPod(in, spriteScale.y)) return false;
+
+    uint32_t animCount = 0;
+    if (!readPod(in, animCount)) return false;
+    // A truncated or corrupt cache must not size the tables.
+    if (animCount > remaining(in) / (sizeof(uint32_t) + sizeof(AnimClip))) return false;
+    names.resize(animCount);
+    clips.resize(animCount);
+    for (uint32_t i = 0; i < animCount; i++) {
+        if (!readString(in, names[i]) || !readPod(in, clips[i])) return false;
+    }
+
+    uint32_t rectCount = 0;
+    if (!readPod(in, rectCount)) return false;
+    if (rectCount > remaining(in) / (4 * sizeof(int32_t))) return false;
+    frameRects.resize(rectCount);
+    for (auto& rect : frameRects) {
+        int32_t v[4];
+        if (!readPod(in, v)) return false;
+        rect = sf::IntRect(v[0], v[1], v[2], v[3]);
+    }
+
+    // Reject tables that would index out of range.
+    for (const auto& clip : clips) {
+        if (clip.firstRect < 0 || clip.frameCount <= 0 ||
+            static_cast<size_t>(clip.firstRect) > frameRects.size() ||
+            static_cast<size_t>(clip.frameCount) > (frameRects.size() - clip.firstRect) / numDirections)
+            return false;
+    }
+    return true;
+}
+
+void SpriteSheetDef::writeBinary(const std::string& file) const {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "[SpriteSheetDef] Could not write cache: " << file << "\n";
+        return;
+    }
+
+    out.write(binaryMagic, 4);
+    writePod(out, binaryVersion);
+    writeString(out, textureFile);
+    writeString(out, animType);
+    writePod(out, spriteSize.x);
+    writePod(out, spriteSize.y);
+    writePod(out, spriteScale.x);
+    writePod(out, spriteScale.y);
+
+    writePod(out, static_cast<uint32_t>(clips.size()));
+    for (size_t i = 0; i < clips.size(); i++) {
+        writeString(out, names[i]);
+        writePod(out, clips[i]);
+    }
+
+    writePod(out, static_cast<uint32_t>(frameRects.size()));
+    for (const auto& rect : frameRects) {
+        int32_t v[4] = { rect.left, rect.top, rect.width, rect.height };
+        writePod(out, v);
+    }
+}
+
+void SpriteSheetDef::finishLoad() {
+    for (size_t i = 0; i < names.size(); i++)
+        animationIDs[names[i]] = static_cast<AnimID>(i);
+    texture = ServiceLocator::getTextures()->get(textureFile);
+
+    // The texture itself is charged by the TextureCache.
+    size_t bytes = sizeof(SpriteSheetDef) + clips.capacity() * sizeof(AnimClip) + frameRects.capacity() * sizeof(sf::IntRect);
+    for (const auto& name : names)
+        bytes += sizeof(std::string) + name.capacity() + sizeof(std::pair<const std::string, AnimID>) + sizeof(void*) * 2;
+    memory.set(bytes);
+}
+
+AnimID SpriteSheetDef::getAnimationID(const std::string& name) const {
+    auto itr = animationIDs.find(name);
+    if (itr == animationIDs.end()) return NoAnimation;
+    return itr->second;
+}
+
+const sf::IntRect* SpriteSheetDef::getFrames(AnimID id, Direction dir) const {
+    const AnimClip& clip = clips[id];
+    return &frameRects[clip.firstRect + clip.frameCount * static_cast<int>(dir)];
+}
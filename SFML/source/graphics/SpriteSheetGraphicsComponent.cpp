@@ -5,10 +5,10 @@ SpriteSheetGraphicsComponent::SpriteSheetGraphicsComponent() {}
 
 SpriteSheetGraphicsComponent::~SpriteSheetGraphicsComponent() {}
 
-void SpriteSheetGraphicsComponent::update(Entity* entity, float elapsed) {
-    spriteSheet.update(elapsed);
+void SpriteSheetGraphicsComponent::update(Entity* entity, float /*elapsed*/) {
+    // Frames are advanced in bulk by the AnimationSystem.
 }
 
-void SpriteSheetGraphicsComponent::draw(Window* window) {
-    window->draw(spriteSheet.getSprite());
+void SpriteSheetGraphicsComponent::draw(RenderCommandList& commands) {
+    spriteSheet.draw(commands);
 }
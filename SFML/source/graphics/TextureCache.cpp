@@ -0,0 +1,107 @@
+#include "../../include/graphics/TextureCache.h"
+#include <iostream>
+#include <stdexcept>
+
+TextureCache::TextureCache(std::shared_ptr<AssetLoader> assetLoader, bool upload)
+    : loader(assetLoader), uploadToGpu(upload) {}
+
+void TextureCache::prefetch(const std::string& file) {
+    if (!loader) return;
+    std::lock_guard<std::mutex> lock(mtx);
+    if (textures.count(file) || pending.count(file)) return;
+    pending[file] = loader->requestImage(file);
+}
+
+std::shared_ptr<const CachedTexture> TextureCache::get(const std::string& file) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = textures.find(file);
+    if (it != textures.end())
+        return it->second;
+    return upload(file);
+}
+
+void TextureCache::finishLoading() {
+    std::lock_guard<std::mutex> lock(mtx);
+    while (!pending.empty())
+        upload(pending.begin()->first);
+}
+
+// Expects mtx to be held.
+std::shared_ptr<const CachedTexture> TextureCache::upload(const std::string& file) {
+    auto tex = std::make_shared<CachedTexture>();
+    if (uploadToGpu)
+        tex->texture = std::make_unique<sf::Texture>();
+    auto found = pending.find(file);
+    if (found != pending.end()) {
+        AssetLoader::ImageHandle image = found->second;
+        pending.erase(found);
+        // The pixels are dropped once uploaded (or measured).
+        loader->release(file);
+        tex->size = image.get()->getSize();
+        if (uploadToGpu && !tex->texture->loadFromImage(*image.get()))
+            throw std::runtime_error("Texture upload failed: " + file);
+    }
+    else if (uploadToGpu) {
+        if (!tex->texture->loadFromFile(file))
+            throw std::runtime_error("Texture load failed: " + file);
+        tex->size = tex->texture->getSize();
+    }
+    else {
+        sf::Image image;
+        if (!image.loadFromFile(file))
+            throw std::runtime_error("Texture load failed: " + file);
+        tex->size = image.getSize();
+    }
+    textures[file] = tex;
+    charge(file, tex->size);
+    return tex;
+}
+
+// Expects mtx to be held. Charged at RGBA size, the same on the GPU and in
+// sf::Image. Without upload no pixels stay resident, so nothing is charged.
+void TextureCache::charge(const std::string& file, const sf::Vector2u& size) {
+    size_t bytes = uploadToGpu ? static_cast<size_t>(size.x) * size.y * 4 : 0;
+    auto it = charges.find(file);
+    if (it == charges.end())
+        charges.emplace(file, MemoryCharge(MemoryTag::Textures, bytes));
+    else
+        it->second.set(bytes);
+}
+
+bool TextureCache::reload(const std::string& file) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = textures.find(file);
+    if (it == textures.end())
+        return false;
+    sf::Image image;
+    if (!image.loadFromFile(file)) {
+        std::cerr << "[TextureCache] Reload failed, keeping old texture: " << file << "\n";
+        return false;
+    }
+    if (uploadToGpu) {
+        sf::Texture fresh;
+        if (!fresh.loadFromImage(image)) {
+            std::cerr << "[TextureCache] Reload failed, keeping old texture: " << file << "\n";
+            return false;
+        }
+        it->second->texture->swap(fresh);
+    }
+    it->second->size = image.getSize();
+    charge(file, image.getSize());
+    return true;
+}
+
+bool TextureCache::contains(const std::string& file) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return textures.count(file) > 0 || pending.count(file) > 0;
+}
+
+std::vector<std::string> TextureCache::getFiles() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<std::string> files;
+    for (const auto& entry : textures)
+        files.push_back(entry.first);
+    for (const auto& entry : pending)
+        files.push_back(entry.first);
+    return files;
+}
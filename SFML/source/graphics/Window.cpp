@@ -1,14 +1,16 @@
 #include "../../include/graphics/Window.h"
-#include "../../include/core/Game.h"
+#include "../../include/graphics/TextureCache.h"
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
 
 Window::Window()
-    : windowTitle("")
-    , windowSize({ 0, 0 })
-    , isFullscreen(false)
+    : windowSize({ 0, 0 })
+    , windowTitle("")
+    , batch(sf::Triangles)
+    , batchTexture(nullptr)
     , isDone(false)
+    , isFullscreen(false)
+    , fullscreenToggleRequested(false)
 {
 }
 
@@ -20,23 +22,8 @@ void Window::loadFont(const std::string& fontFile)
         throw std::runtime_error("Font file not found for Window: " + fontFile);
     }
 
-    // Set up FPS text.
-    fpsText.setCharacterSize(fontSize);
-    fpsText.setFillColor(sf::Color::Red);
-    fpsText.setFont(guiFont);
-
-    // Set up paused text.
-    pausedText.setCharacterSize(fontSize + 10);
-    pausedText.setFillColor(sf::Color::Blue);
-    pausedText.setFont(guiFont);
-    pausedText.setString("PAUSED!");
-
-    // Set up health display text.
-    healthText.setCharacterSize(fontSize);
-    healthText.setFillColor(sf::Color::Green);
-    healthText.setFont(guiFont);
-    healthText.setPosition(10.f, 60.f);
-    healthText.setString("Health: 100/100");
+    // FPS, health, wood and paused widgets.
+    hud.init(guiFont, fontSize);
 }
 
 void Window::setup(const std::string& title, const sf::Vector2u& size)
@@ -50,7 +37,9 @@ void Window::create()
 {
     auto style = (isFullscreen ? sf::Style::Fullscreen : sf::Style::Default);
     window.create({ windowSize.x, windowSize.y, 32 }, windowTitle, style);
-    pausedText.setPosition(windowSize.x * 0.5f, 0.0f);
+    // Held keys are tracked from press/release pairs, so OS auto-repeat would only add noise.
+    window.setKeyRepeatEnabled(false);
+    hud.resize(windowSize);
 }
 
 void Window::destroy()
@@ -62,13 +51,36 @@ void Window::update()
 {
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed)
+        switch (event.type) {
+        case sf::Event::Closed:
             isDone = true;
-        else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F5)
-            toggleFullscreen();
+            break;
+        case sf::Event::KeyPressed:
+            if (event.key.code == sf::Keyboard::F5)
+                fullscreenToggleRequested = true;
+            else
+                input.push(event.key.code, true);
+            break;
+        case sf::Event::KeyReleased:
+            input.push(event.key.code, false);
+            break;
+        case sf::Event::LostFocus:
+            // Releases would go to another window; don't leave keys stuck down.
+            input.releaseAll();
+            break;
+        default:
+            break;
+        }
     }
 }
 
+bool Window::consumeFullscreenToggle()
+{
+    bool requested = fullscreenToggleRequested;
+    fullscreenToggleRequested = false;
+    return requested;
+}
+
 void Window::toggleFullscreen()
 {
     isFullscreen = !isFullscreen;
@@ -81,31 +93,85 @@ void Window::redraw()
     create();
 }
 
-void Window::beginDraw() { window.clear(sf::Color::Black); }
-void Window::endDraw() { window.display(); }
+void Window::beginFrame() { window.clear(sf::Color::Black); }
+void Window::endFrame() { window.display(); }
 
 bool Window::isWindowDone() const { return isDone; }
 bool Window::isWindowFullscreen() const { return isFullscreen; }
 const sf::Vector2u& Window::getWindowSize() const { return windowSize; }
 const sf::Font& Window::getGUIFont() const { return guiFont; }
-sf::Text& Window::getFPSText() { return fpsText; }
 
-void Window::drawGUI(const Game& game)
+void Window::submit(const RenderCommandList& commands)
 {
-    window.draw(fpsText);
-    if (game.getPlayer()) {
-        auto playerHealth = game.getPlayer()->getHealthComp()->getHealth();
-        auto maxHealth = game.getPlayer()->getHealthComp()->getMaxHealth();
-        std::ostringstream ss;
-        ss << "Health: " << playerHealth << "/" << maxHealth;
-        healthText.setString(ss.str());
-        window.draw(healthText);
+    for (const auto& cmd : commands.getCommands()) {
+        switch (cmd.type) {
+        case RenderCommandType::View:
+            flushBatch();
+            window.setView(cmd.viewIndex >= 0 ? commands.getView(cmd.viewIndex) : window.getDefaultView());
+            break;
+        case RenderCommandType::Quad:
+        {
+            const sf::Texture* texture = cmd.texture ? cmd.texture->getTexture() : nullptr;
+            if (texture != batchTexture)
+                flushBatch();
+            batchTexture = texture;
+            sf::FloatRect area(cmd.position.x, cmd.position.y,
+                cmd.textureRect.width * cmd.scale.x, cmd.textureRect.height * cmd.scale.y);
+            appendQuad(area, cmd.textureRect, sf::Color::White);
+            break;
+        }
+        case RenderCommandType::Rect:
+        {
+            // Outline drawn outside the bounds as four untextured quads.
+            if (batchTexture != nullptr)
+                flushBatch();
+            batchTexture = nullptr;
+            const sf::FloatRect& b = cmd.bounds;
+            float t = cmd.thickness;
+            sf::IntRect none;
+            appendQuad({ b.left - t, b.top - t, b.width + 2 * t, t }, none, cmd.color);
+            appendQuad({ b.left - t, b.top + b.height, b.width + 2 * t, t }, none, cmd.color);
+            appendQuad({ b.left - t, b.top, t, b.height }, none, cmd.color);
+            appendQuad({ b.left + b.width, b.top, t, b.height }, none, cmd.color);
+            break;
+        }
+        case RenderCommandType::Vertices:
+            flushBatch();
+            window.draw(&commands.getVertices()[cmd.firstVertex], cmd.vertexCount, sf::Triangles,
+                sf::RenderStates(cmd.texture ? cmd.texture->getTexture() : nullptr));
+            break;
+        case RenderCommandType::Hud:
+            flushBatch();
+            hud.update(commands.getHudState());
+            hud.draw(window);
+            break;
+        }
     }
-    if (game.isPaused()) {
-        window.draw(pausedText);
+    flushBatch();
+}
+
+void Window::appendQuad(const sf::FloatRect& area, const sf::IntRect& texRect, const sf::Color& color)
+{
+    float l = area.left, t = area.top, r = area.left + area.width, b = area.top + area.height;
+    float tl = static_cast<float>(texRect.left), tt = static_cast<float>(texRect.top);
+    float tr = tl + texRect.width, tb = tt + texRect.height;
+
+    batch.append(sf::Vertex({ l, t }, color, { tl, tt }));
+    batch.append(sf::Vertex({ r, t }, color, { tr, tt }));
+    batch.append(sf::Vertex({ r, b }, color, { tr, tb }));
+    batch.append(sf::Vertex({ l, t }, color, { tl, tt }));
+    batch.append(sf::Vertex({ r, b }, color, { tr, tb }));
+    batch.append(sf::Vertex({ l, b }, color, { tl, tb }));
+}
+
+void Window::flushBatch()
+{
+    if (batch.getVertexCount() > 0) {
+        window.draw(batch, sf::RenderStates(batchTexture));
+        batch.clear();
     }
 }
 
-void Window::draw(sf::Drawable& drawable) {
-    window.draw(drawable);
+void Window::setActive(bool active) {
+    window.setActive(active);
 }
@@ -0,0 +1,113 @@
+#include "../../include/systems/AnimationSystem.h"
+
+AnimationSystem::Handle AnimationSystem::add(sf::Sprite* sprite)
+{
+    Handle h;
+    if (!freeSlots.empty()) {
+        h = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        h = static_cast<Handle>(slotToDense.size());
+        slotToDense.push_back(-1);
+    }
+
+    slotToDense[h] = static_cast<int>(sprites.size());
+    denseToSlot.push_back(h);
+    sprites.push_back(sprite);
+    frameTables.push_back(nullptr);
+    frameCount.push_back(0);
+    frame.push_back(0);
+    frameTime.push_back(1.f);
+    elapsedTime.push_back(0.f);
+    flags.push_back(0);
+    return h;
+}
+
+void AnimationSystem::remove(Handle h)
+{
+    int idx = slotToDense[h];
+    int last = static_cast<int>(sprites.size()) - 1;
+    if (idx != last) {
+        sprites[idx] = sprites[last];
+        frameTables[idx] = frameTables[last];
+        frameCount[idx] = frameCount[last];
+        frame[idx] = frame[last];
+        frameTime[idx] = frameTime[last];
+        elapsedTime[idx] = elapsedTime[last];
+        flags[idx] = flags[last];
+        denseToSlot[idx] = denseToSlot[last];
+        slotToDense[denseToSlot[idx]] = idx;
+    }
+    sprites.pop_back();
+    frameTables.pop_back();
+    frameCount.pop_back();
+    frame.pop_back();
+    frameTime.pop_back();
+    elapsedTime.pop_back();
+    flags.pop_back();
+    denseToSlot.pop_back();
+    slotToDense[h] = -1;
+    freeSlots.push_back(h);
+}
+
+void AnimationSystem::play(Handle h, const sf::IntRect* frames, int count, float fTime, bool loop, bool playing)
+{
+    int idx = slotToDense[h];
+    frameTables[idx] = frames;
+    frameCount[idx] = count;
+    frame[idx] = 0;
+    frameTime[idx] = fTime;
+    elapsedTime[idx] = 0.f;
+    flags[idx] = (playing ? Playing : 0) | (loop ? Looping : 0);
+    if (count > 0)
+        sprites[idx]->setTextureRect(frames[0]);
+}
+
+void AnimationSystem::setFrames(Handle h, const sf::IntRect* frames)
+{
+    int idx = slotToDense[h];
+    frameTables[idx] = frames;
+    if (frameCount[idx] > 0)
+        sprites[idx]->setTextureRect(frames[frame[idx]]);
+}
+
+void AnimationSystem::retarget(Handle h, const sf::IntRect* frames, int count, float fTime)
+{
+    int idx = slotToDense[h];
+    frameTables[idx] = frames;
+    frameCount[idx] = count;
+    frameTime[idx] = fTime;
+    if (frame[idx] >= count)
+        frame[idx] = count > 0 ? count - 1 : 0;
+    if (count > 0)
+        sprites[idx]->setTextureRect(frames[frame[idx]]);
+}
+
+void AnimationSystem::update(float elapsed)
+{
+    const size_t count = sprites.size();
+    for (size_t i = 0; i < count; i++) {
+        if (!(flags[i] & Playing))
+            continue;
+
+        elapsedTime[i] += elapsed;
+        if (elapsedTime[i] < frameTime[i])
+            continue;
+        elapsedTime[i] = 0.f;
+
+        int next = frame[i] + 1;
+        if (next >= frameCount[i]) {
+            if (flags[i] & Looping) {
+                next = 0;
+            }
+            else {
+                // Hold the last frame and stop playing.
+                next = frameCount[i] - 1;
+                flags[i] &= ~Playing;
+            }
+        }
+        frame[i] = next;
+        sprites[i]->setTextureRect(frameTables[i][next]);
+    }
+}
@@ -5,6 +5,7 @@
 #include "../../include/utils/Rectangle.h"
 #include "../../include/core/Game.h"
 #include "../../include/core/ServiceLocator.h"
+#include "../../include/core/GameEvents.h"
 #include <iostream>
 
 GameplaySystem::GameplaySystem() {
@@ -42,10 +43,7 @@ void GameplaySystem::update(Game* game, Entity* entity, float) {
                     << " health, new health: " << player->getHealthComp()->getHealth() << std::endl;
                 // Mark the potion for deletion.
                 entity->deleteEntity();
-                if (player->getObserver()) {
-                    player->getObserver()->onPotionCollected();
-                    ServiceLocator::getAudio()->playSound("pickup");
-                }
+                ServiceLocator::getEvents()->publish(PotionCollected{ potionHealth, entity->getPosition() });
             }
             break;
         }
@@ -60,6 +58,7 @@ void GameplaySystem::update(Game* game, Entity* entity, float) {
                     player->addWood(woodCollected);
                     std::cout << "Log collision: Collected " << woodCollected
                         << " wood, total wood: " << player->getWood() << std::endl;
+                    ServiceLocator::getEvents()->publish(WoodCollected{ woodCollected, player->getWood() });
                     // Mark the log for deletion.
                     entity->deleteEntity();
                 }
@@ -1,7 +1,6 @@
 #include "../../include/systems/Systems.h"
 #include "../../include/components/GraphicsComponent.h"
 #include "../../include/entities/Entity.h"
-#include "../../include/graphics/Window.h"
 #include "../../include/core/Game.h"
 #include <stdexcept>
 
@@ -22,6 +21,6 @@ void GraphicsSystem::update(Game* game, Entity* entity, float elapsed) {
     // Update the graphics component (e.g., update animations)
     graphicsComp->update(entity, elapsed);
 
-    // Draw the graphics component on the game's window.
-    graphicsComp->draw(game->getWindow());
+    // Queue the graphics component for the next frame.
+    graphicsComp->draw(game->getOverlayCommands());
 }
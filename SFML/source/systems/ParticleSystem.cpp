@@ -0,0 +1,236 @@
+#include "../../include/systems/ParticleSystem.h"
+#include "../../include/entities/Entity.h"
+#include "../../include/graphics/RenderCommands.h"
+#include "../../include/utils/Rectangle.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PARTICLES_SSE2 1
+#endif
+
+namespace {
+    // The standard distributions differ between library implementations;
+    // this only relies on mt19937's specified output.
+    float unit(std::mt19937& rng) {
+        return static_cast<float>(rng() / 4294967296.0);
+    }
+}
+
+ParticleSystem::ParticleSystem(size_t capacity, std::uint32_t seed)
+    : maxParticles(capacity), count(0), memory(MemoryTag::Particles), rng(seed)
+{
+    // Pools are allocated once; spawning and retiring only move the live count.
+    for (auto* pool : { &posX, &posY, &velX, &velY, &accX, &accY, &age, &lifetime, &extent })
+        pool->assign(capacity, 0.f);
+    startColor.resize(capacity);
+    endColor.resize(capacity);
+    memory.set(capacity * (9 * sizeof(float) + 2 * sizeof(sf::Color)));
+}
+
+void ParticleSystem::spawn(const sf::Vector2f& position, const ParticleEmitterSettings& settings) {
+    if (count >= maxParticles) return;
+
+    float angle = settings.direction + (unit(rng) - 0.5f) * settings.spread;
+    float speed = settings.speedMin + unit(rng) * (settings.speedMax - settings.speedMin);
+
+    size_t i = count++;
+    posX[i] = position.x;
+    posY[i] = position.y;
+    velX[i] = std::cos(angle) * speed;
+    velY[i] = std::sin(angle) * speed;
+    accX[i] = settings.acceleration.x;
+    accY[i] = settings.acceleration.y;
+    age[i] = 0.f;
+    lifetime[i] = settings.lifetimeMin + unit(rng) * (settings.lifetimeMax - settings.lifetimeMin);
+    extent[i] = settings.size;
+    startColor[i] = settings.startColor;
+    endColor[i] = settings.endColor;
+}
+
+void ParticleSystem::burst(const sf::Vector2f& position, int amount, const ParticleEmitterSettings& settings) {
+    for (int i = 0; i < amount && count < maxParticles; i++)
+        spawn(position, settings);
+}
+
+ParticleSystem::EmitterHandle ParticleSystem::attach(std::shared_ptr<Entity> target, const ParticleEmitterSettings& settings,
+                                                     const sf::Vector2f& offset) {
+    EmitterHandle h;
+    if (!freeEmitters.empty()) {
+        h = freeEmitters.back();
+        freeEmitters.pop_back();
+    }
+    else {
+        h = static_cast<EmitterHandle>(emitters.size());
+        emitters.emplace_back();
+    }
+    Emitter& e = emitters[h];
+    e.target = target;
+    e.settings = settings;
+    e.offset = offset;
+    e.pending = 0.f;
+    e.active = true;
+    return h;
+}
+
+void ParticleSystem::detach(EmitterHandle h, const Entity* target) {
+    if (h < 0 || h >= static_cast<EmitterHandle>(emitters.size()) || !emitters[h].active) return;
+    if (target && emitters[h].target.lock().get() != target) return;
+    emitters[h].active = false;
+    emitters[h].target.reset();
+    freeEmitters.push_back(h);
+}
+
+void ParticleSystem::integrate(float elapsed) {
+    size_t i = 0;
+#ifdef PARTICLES_SSE2
+    const __m128 dt = _mm_set1_ps(elapsed);
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(&velX[i]), _mm_mul_ps(_mm_loadu_ps(&accX[i]), dt));
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(&velY[i]), _mm_mul_ps(_mm_loadu_ps(&accY[i]), dt));
+        _mm_storeu_ps(&velX[i], vx);
+        _mm_storeu_ps(&velY[i], vy);
+        _mm_storeu_ps(&posX[i], _mm_add_ps(_mm_loadu_ps(&posX[i]), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&posY[i], _mm_add_ps(_mm_loadu_ps(&posY[i]), _mm_mul_ps(vy, dt)));
+        _mm_storeu_ps(&age[i], _mm_add_ps(_mm_loadu_ps(&age[i]), dt));
+    }
+#endif
+    for (; i < count; i++) {
+        velX[i] += accX[i] * elapsed;
+        velY[i] += accY[i] * elapsed;
+        posX[i] += velX[i] * elapsed;
+        posY[i] += velY[i] * elapsed;
+        age[i] += elapsed;
+    }
+}
+
+void ParticleSystem::retire() {
+    // Swap-remove expired particles so the live range stays packed.
+    for (size_t i = 0; i < count;) {
+        if (age[i] < lifetime[i]) {
+            i++;
+            continue;
+        }
+        size_t last = --count;
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        velX[i] = velX[last];
+        velY[i] = velY[last];
+        accX[i] = accX[last];
+        accY[i] = accY[last];
+        age[i] = age[last];
+        lifetime[i] = lifetime[last];
+        extent[i] = extent[last];
+        startColor[i] = startColor[last];
+        endColor[i] = endColor[last];
+    }
+}
+
+void ParticleSystem::update(float elapsed) {
+    for (size_t h = 0; h < emitters.size(); h++) {
+        Emitter& e = emitters[h];
+        if (!e.active) continue;
+        auto target = e.target.lock();
+        if (!target || target->isDeleted()) {
+            detach(static_cast<EmitterHandle>(h));
+            continue;
+        }
+        const Rectangle& bb = target->getBoundingBox();
+        sf::Vector2f origin((bb.getTopLeft().x + bb.getBottomRight().x) * 0.5f + e.offset.x,
+                            (bb.getTopLeft().y + bb.getBottomRight().y) * 0.5f + e.offset.y);
+        e.pending += e.settings.rate * elapsed;
+        while (e.pending >= 1.f) {
+            spawn(origin, e.settings);
+            e.pending -= 1.f;
+        }
+    }
+
+    integrate(elapsed);
+    retire();
+}
+
+void ParticleSystem::draw(RenderCommandList& commands, const Rectangle& view) const {
+    if (count == 0) return;
+
+    const float left = view.getTopLeft().x, top = view.getTopLeft().y;
+    const float right = view.getBottomRight().x, bottom = view.getBottomRight().y;
+    std::vector<sf::Vertex>& out = commands.beginVertices(nullptr);
+    out.reserve(out.size() + count * 6);
+    for (size_t i = 0; i < count; i++) {
+        float half = extent[i] * 0.5f;
+        float l = posX[i] - half, t = posY[i] - half, r = posX[i] + half, b = posY[i] + half;
+        if (r < left || l > right || b < top || t > bottom) continue;
+
+        // Fade from the start to the end colour over the particle's life.
+        float k = age[i] / lifetime[i];
+        const sf::Color& from = startColor[i];
+        const sf::Color& to = endColor[i];
+        sf::Color c(static_cast<sf::Uint8>(from.r + (to.r - from.r) * k),
+                    static_cast<sf::Uint8>(from.g + (to.g - from.g) * k),
+                    static_cast<sf::Uint8>(from.b + (to.b - from.b) * k),
+                    static_cast<sf::Uint8>(from.a + (to.a - from.a) * k));
+
+        out.emplace_back(sf::Vector2f(l, t), c);
+        out.emplace_back(sf::Vector2f(r, t), c);
+        out.emplace_back(sf::Vector2f(r, b), c);
+        out.emplace_back(sf::Vector2f(l, t), c);
+        out.emplace_back(sf::Vector2f(r, b), c);
+        out.emplace_back(sf::Vector2f(l, b), c);
+    }
+    commands.endVertices();
+}
+
+namespace ParticleEffects {
+    ParticleEmitterSettings fireTrail() {
+        ParticleEmitterSettings s;
+        s.rate = 240.f;
+        s.speedMin = 10.f;
+        s.speedMax = 40.f;
+        s.lifetimeMin = 0.2f;
+        s.lifetimeMax = 0.5f;
+        s.size = 8.f;
+        s.acceleration = sf::Vector2f(0.f, -60.f);
+        s.startColor = sf::Color(255, 200, 40);
+        s.endColor = sf::Color(200, 30, 0, 0);
+        return s;
+    }
+
+    ParticleEmitterSettings shout() {
+        ParticleEmitterSettings s;
+        s.speedMin = 120.f;
+        s.speedMax = 260.f;
+        s.lifetimeMin = 0.2f;
+        s.lifetimeMax = 0.4f;
+        s.size = 5.f;
+        s.startColor = sf::Color(255, 240, 200);
+        s.endColor = sf::Color(255, 120, 0, 0);
+        return s;
+    }
+
+    ParticleEmitterSettings pickup() {
+        ParticleEmitterSettings s;
+        s.direction = -1.5707963f;
+        s.spread = 1.5f;
+        s.speedMin = 40.f;
+        s.speedMax = 120.f;
+        s.size = 5.f;
+        s.acceleration = sf::Vector2f(0.f, 120.f);
+        s.startColor = sf::Color(120, 255, 140);
+        s.endColor = sf::Color(40, 160, 255, 0);
+        return s;
+    }
+
+    ParticleEmitterSettings woodChips() {
+        ParticleEmitterSettings s;
+        s.speedMin = 60.f;
+        s.speedMax = 160.f;
+        s.lifetimeMin = 0.3f;
+        s.lifetimeMax = 0.6f;
+        s.size = 4.f;
+        s.acceleration = sf::Vector2f(0.f, 300.f);
+        s.startColor = sf::Color(160, 100, 40);
+        s.endColor = sf::Color(110, 70, 30, 0);
+        return s;
+    }
+}
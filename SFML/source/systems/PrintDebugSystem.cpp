@@ -1,7 +1,7 @@
 #include "../../include/systems/Systems.h"
 #include "../../include/components/ColliderComponent.h"
 #include "../../include/entities/Entity.h"
-#include "../../include/graphics/Window.h"
+#include "../../include/core/Game.h"
 #include <stdexcept>
 
 PrintDebugSystem::PrintDebugSystem() {
@@ -19,11 +19,6 @@ void PrintDebugSystem::update(Game* game, Entity* entity, float ) {
         throw std::runtime_error("PrintDebugSystem: Entity lacks a ColliderComponent");
     }
 
-    // Retrieve a reference to the SFML drawable rectangle from the ColliderComponent's bounding box.
-    //auto& debugRect = colliderComp->getBoundingBox().getDrawableRect();
-    auto boundingBox = colliderComp->getBoundingBox();
-    auto& debugRect = boundingBox.getDrawableRect();
-
-    // Draw the debug rectangle on the window.
-    game->getWindow()->draw(debugRect);
+    // Queue the bounding box outline for the next frame.
+    colliderComp->draw(game->getOverlayCommands());
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "../../include/utils/FileWatcher.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace {
+    // Splits a path into a directory usable for watching and a bare file name.
+    void splitPath(const std::string& file, std::string& dir, std::string& name) {
+        std::filesystem::path p(file);
+        dir = p.parent_path().string();
+        if (dir.empty()) dir = ".";
+        name = p.filename().string();
+    }
+}
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher() : fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+    if (fd < 0)
+        std::cerr << "[FileWatcher] inotify unavailable, hot reload disabled\n";
+}
+
+FileWatcher::~FileWatcher()
+{
+    if (fd >= 0) close(fd);
+}
+
+void FileWatcher::watch(const std::string& file)
+{
+    if (fd < 0) return;
+    std::string dir, name;
+    splitPath(file, dir, name);
+    // Watching the directory also catches editors that save via rename.
+    // IN_CREATE is left out: it fires before the new file has any content.
+    int wd = inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        std::cerr << "[FileWatcher] Cannot watch " << dir << "\n";
+        return;
+    }
+    watchedDirs[wd] = dir;
+    watched[dir + "/" + name] = file;
+}
+
+void FileWatcher::poll(std::vector<std::string>& changed)
+{
+    if (fd < 0) return;
+    size_t first = changed.size();
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t len = read(fd, buffer, sizeof(buffer));
+        if (len <= 0) break;
+        for (ssize_t offset = 0; offset < len;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+            if (event->len == 0) continue;
+            auto dir = watchedDirs.find(event->wd);
+            if (dir == watchedDirs.end()) continue;
+            auto file = watched.find(dir->second + "/" + event->name);
+            if (file == watched.end()) continue;
+            // One save can raise several events; report each file once.
+            if (std::find(changed.begin() + first, changed.end(), file->second) == changed.end())
+                changed.push_back(file->second);
+        }
+    }
+}
+
+#else
+
+FileWatcher::FileWatcher() : lastPoll(std::chrono::steady_clock::now()) {}
+
+FileWatcher::~FileWatcher() {}
+
+void FileWatcher::watch(const std::string& file)
+{
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(file, ec);
+    watched[file] = ec ? std::filesystem::file_time_type::min() : time;
+}
+
+void FileWatcher::poll(std::vector<std::string>& changed)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastPoll < pollInterval) return;
+    lastPoll = now;
+
+    for (auto& entry : watched) {
+        std::error_code ec;
+        auto time = std::filesystem::last_write_time(entry.first, ec);
+        // A file being replaced may be missing for a moment; try again next poll.
+        if (ec || time == entry.second) continue;
+        entry.second = time;
+        changed.push_back(entry.first);
+    }
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "../../include/utils/MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : bytes(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+{
+}
+
+void MappedFile::open(const std::string& file)
+{
+    close();
+    // FILE_SHARE_DELETE lets another process rename the file while it is
+    // mapped, which LevelSource::replaceFile relies on.
+    fileHandle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("MappedFile: cannot open " + file);
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        close();
+        throw std::runtime_error("MappedFile: empty or unreadable file " + file);
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle)
+        bytes = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!bytes) {
+        close();
+        throw std::runtime_error("MappedFile: cannot map " + file);
+    }
+}
+
+void MappedFile::close()
+{
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    bytes = nullptr;
+    length = 0;
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+MappedFile::MappedFile()
+    : bytes(nullptr), length(0), fd(-1)
+{
+}
+
+void MappedFile::open(const std::string& file)
+{
+    close();
+    fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("MappedFile: cannot open " + file);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close();
+        throw std::runtime_error("MappedFile: empty or unreadable file " + file);
+    }
+    length = static_cast<size_t>(info.st_size);
+
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        close();
+        throw std::runtime_error("MappedFile: cannot map " + file);
+    }
+    bytes = static_cast<const unsigned char*>(mapped);
+}
+
+void MappedFile::close()
+{
+    if (bytes) munmap(const_cast<unsigned char*>(bytes), length);
+    if (fd >= 0) ::close(fd);
+    bytes = nullptr;
+    length = 0;
+    fd = -1;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}